@@ -0,0 +1,286 @@
+#include "AabbBatch.h"
+
+// SIMD kernels only on x86 (SSE is always available on x64 and with the default `/arch:SSE2`),
+// AVX2 kernel is compiled without global compiler flags and used only if the CPU supports it.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AABB_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AABB_TARGET_AVX2
+#else
+#define AABB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+
+// Kernels (box `first + i` is tested for `i` from `start` to `count - 1`, its hit is written as bit `i` of the mask):
+
+/// <summary>
+/// Tests the box against the boxes one by one.
+/// </summary>
+/// <returns>Returns number of the hits.</returns>
+static std::size_t findOverlapsScalar(const AabbBatch& boxes, const sf::FloatRect& box,
+										std::size_t first, std::size_t start, std::size_t count, std::uint64_t* mask)
+{
+	const float boxMaxX = box.left + box.width;
+	const float boxMaxY = box.top + box.height;
+	std::size_t hits = 0;
+	for (std::size_t i = start; i < count; i++)
+	{
+		const std::size_t index = first + i;
+		// Touching boxes do not overlap (same as `EntityStore::isOverlapping`), no branches.
+		const bool overlap = (boxes.minX_[index] < boxMaxX) & (box.left < boxes.maxX_[index]) &
+			(boxes.minY_[index] < boxMaxY) & (box.top < boxes.maxY_[index]);
+		mask[i / 64] |= std::uint64_t(overlap) << (i % 64);
+		hits += overlap;
+	}
+
+	return hits;
+}
+
+#ifdef AABB_SIMD
+/// <summary>
+/// Tests the box against four boxes at once (rest of the boxes one by one).
+/// </summary>
+/// <returns>Returns number of the hits.</returns>
+static std::size_t findOverlapsSse(const AabbBatch& boxes, const sf::FloatRect& box,
+									std::size_t first, std::size_t start, std::size_t count, std::uint64_t* mask)
+{
+	const __m128 boxMinX = _mm_set1_ps(box.left);
+	const __m128 boxMinY = _mm_set1_ps(box.top);
+	const __m128 boxMaxX = _mm_set1_ps(box.left + box.width);
+	const __m128 boxMaxY = _mm_set1_ps(box.top + box.height);
+
+	std::size_t hits = 0;
+	std::size_t i = start;
+	for (; i + 4 <= count; i += 4)
+	{
+		const std::size_t index = first + i;
+		const __m128 overlapX = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&boxes.minX_[index]), boxMaxX),
+											_mm_cmplt_ps(boxMinX, _mm_loadu_ps(&boxes.maxX_[index])));
+		const __m128 overlapY = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&boxes.minY_[index]), boxMaxY),
+											_mm_cmplt_ps(boxMinY, _mm_loadu_ps(&boxes.maxY_[index])));
+		const int bits = _mm_movemask_ps(_mm_and_ps(overlapX, overlapY));
+		if (bits != 0)
+		{
+			// Groups of four bits never cross the word.
+			mask[i / 64] |= std::uint64_t(bits) << (i % 64);
+			hits += (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + ((bits >> 3) & 1);
+		}
+	}
+
+	if (i < count)
+		hits += findOverlapsScalar(boxes, box, first, i, count, mask);
+	return hits;
+}
+
+/// <summary>
+/// Tests the box against eight boxes at once, rest of the boxes by the masked loads
+/// (no legacy SSE code mixed in, the AVX-SSE transition costs more than the whole test).
+/// </summary>
+/// <returns>Returns number of the hits.</returns>
+AABB_TARGET_AVX2
+static std::size_t findOverlapsAvx2(const AabbBatch& boxes, const sf::FloatRect& box,
+									std::size_t first, std::size_t start, std::size_t count, std::uint64_t* mask)
+{
+	const __m256 boxMinX = _mm256_set1_ps(box.left);
+	const __m256 boxMinY = _mm256_set1_ps(box.top);
+	const __m256 boxMaxX = _mm256_set1_ps(box.left + box.width);
+	const __m256 boxMaxY = _mm256_set1_ps(box.top + box.height);
+
+	std::size_t hits = 0;
+	std::size_t i = start;
+	for (; i + 8 <= count; i += 8)
+	{
+		const std::size_t index = first + i;
+		const __m256 overlapX = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_loadu_ps(&boxes.minX_[index]), boxMaxX, _CMP_LT_OQ),
+			_mm256_cmp_ps(boxMinX, _mm256_loadu_ps(&boxes.maxX_[index]), _CMP_LT_OQ));
+		const __m256 overlapY = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_loadu_ps(&boxes.minY_[index]), boxMaxY, _CMP_LT_OQ),
+			_mm256_cmp_ps(boxMinY, _mm256_loadu_ps(&boxes.maxY_[index]), _CMP_LT_OQ));
+		const int bits = _mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY));
+		if (bits != 0)
+		{
+			// Groups of eight bits never cross the word.
+			mask[i / 64] |= std::uint64_t(bits) << (i % 64);
+			for (int bit = bits; bit != 0; bit &= bit - 1)
+				hits++;
+		}
+	}
+
+	if (i < count)
+	// Less than eight boxes left -> lanes after the last box are not loaded (and never hit).
+	{
+		const std::size_t index = first + i;
+		const __m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count - i)),
+			_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		const __m256 overlapX = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_maskload_ps(&boxes.minX_[index], lanes), boxMaxX, _CMP_LT_OQ),
+			_mm256_cmp_ps(boxMinX, _mm256_maskload_ps(&boxes.maxX_[index], lanes), _CMP_LT_OQ));
+		const __m256 overlapY = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_maskload_ps(&boxes.minY_[index], lanes), boxMaxY, _CMP_LT_OQ),
+			_mm256_cmp_ps(boxMinY, _mm256_maskload_ps(&boxes.maxY_[index], lanes), _CMP_LT_OQ));
+		const int bits = _mm256_movemask_ps(
+			_mm256_and_ps(_mm256_and_ps(overlapX, overlapY), _mm256_castsi256_ps(lanes)));
+		if (bits != 0)
+		{
+			// Tail starts at the multiple of eight -> never crosses the word.
+			mask[i / 64] |= std::uint64_t(bits) << (i % 64);
+			for (int bit = bits; bit != 0; bit &= bit - 1)
+				hits++;
+		}
+	}
+
+	return hits;
+}
+#endif
+
+
+AabbBatch::AabbBatch() {}
+
+/// <summary>
+/// Preallocates memory of all the borders.
+/// </summary>
+/// <param name="capacity">Number of the boxes.</param>
+void AabbBatch::reserve(std::size_t capacity)
+{
+	this->minX_.reserve(capacity);
+	this->minY_.reserve(capacity);
+	this->maxX_.reserve(capacity);
+	this->maxY_.reserve(capacity);
+}
+
+/// <summary>
+/// Changes number of the boxes (new boxes have to be set by `set`).
+/// </summary>
+/// <param name="size">Number of the boxes.</param>
+void AabbBatch::resize(std::size_t size)
+{
+	this->minX_.resize(size);
+	this->minY_.resize(size);
+	this->maxX_.resize(size);
+	this->maxY_.resize(size);
+}
+
+/// <summary>
+/// Removes all the boxes (memory is kept).
+/// </summary>
+void AabbBatch::clear()
+{
+	this->resize(0);
+}
+
+/// <summary>
+/// Adds box to the end of the batch.
+/// </summary>
+/// <param name="bounds">Box to add (absolute coordinates).</param>
+void AabbBatch::add(const sf::FloatRect& bounds)
+{
+	this->resize(this->size() + 1);
+	this->set(this->size() - 1, bounds);
+}
+
+/// <summary>
+/// Changes borders of the box.
+/// </summary>
+/// <param name="index">Index of the box.</param>
+/// <param name="bounds">New box (absolute coordinates).</param>
+void AabbBatch::set(std::size_t index, const sf::FloatRect& bounds)
+{
+	this->minX_[index] = bounds.left;
+	this->minY_[index] = bounds.top;
+	this->maxX_[index] = bounds.left + bounds.width;
+	this->maxY_[index] = bounds.top + bounds.height;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the boxes.</returns>
+std::size_t AabbBatch::size() const
+{
+	return this->minX_.size();
+}
+
+/// <summary>
+/// Finds boxes overlapping the given box (touching boxes do not overlap),
+/// uses the best kernel supported by the CPU.
+/// </summary>
+/// <param name="box">Box to test (absolute coordinates, positive size).</param>
+/// <param name="first">Index of the first tested box.</param>
+/// <param name="count">Number of the tested boxes.</param>
+/// <param name="mask">Bit `i` is set if the box `first + i` overlaps (bit `i % 64` of the word `i / 64`).</param>
+/// <returns>Returns number of the overlapping boxes.</returns>
+std::size_t AabbBatch::findOverlaps(const sf::FloatRect& box, std::size_t first, std::size_t count,
+									std::vector<std::uint64_t>& mask) const
+{
+	static const SimdLevel supportedLevel = getSupportedSimdLevel();
+	return this->findOverlaps(box, first, count, mask, supportedLevel);
+}
+
+/// <summary>
+/// Finds boxes overlapping the given box with the given kernel
+/// (kernels not supported by the CPU are replaced by the best supported one).
+/// </summary>
+/// <param name="box">Box to test (absolute coordinates, positive size).</param>
+/// <param name="first">Index of the first tested box.</param>
+/// <param name="count">Number of the tested boxes.</param>
+/// <param name="mask">Bit `i` is set if the box `first + i` overlaps (bit `i % 64` of the word `i / 64`).</param>
+/// <param name="level">Kernel to use.</param>
+/// <returns>Returns number of the overlapping boxes.</returns>
+std::size_t AabbBatch::findOverlaps(const sf::FloatRect& box, std::size_t first, std::size_t count,
+									std::vector<std::uint64_t>& mask, SimdLevel level) const
+{
+	mask.assign((count + 63) / 64, 0);
+	if (count == 0)
+		return 0;
+
+#ifdef AABB_SIMD
+	static const SimdLevel supportedLevel = getSupportedSimdLevel();
+	if (level > supportedLevel)
+		level = supportedLevel;
+	// Too few boxes for the wide kernel (e.g. buckets of the grid, setup of the registers is not worth it).
+	if (level == SIMD_AVX2 && count < 8)
+		level = SIMD_SSE;
+	if (level == SIMD_SSE && count < 4)
+		level = SIMD_SCALAR;
+
+	if (level == SIMD_AVX2)
+		return findOverlapsAvx2(*this, box, first, 0, count, mask.data());
+	if (level == SIMD_SSE)
+		return findOverlapsSse(*this, box, first, 0, count, mask.data());
+#endif
+	return findOverlapsScalar(*this, box, first, 0, count, mask.data());
+}
+
+/// <summary>
+/// Detects instruction sets of the CPU (and whether the OS saves AVX registers).
+/// </summary>
+/// <returns>Returns the best kernel which can be used.</returns>
+SimdLevel AabbBatch::getSupportedSimdLevel()
+{
+#if !defined(AABB_SIMD)
+	return SIMD_SCALAR;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int maxFunction = info[0];
+
+	__cpuid(info, 1);
+	const bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+		(_xgetbv(0) & 0x6) == 0x6;
+	if (maxFunction >= 7 && osSavesAvx)
+	{
+		__cpuidex(info, 7, 0);
+		if (info[1] & (1 << 5))
+			return SIMD_AVX2;
+	}
+	return SIMD_SSE;
+#else
+	// Checks also the OS support of the AVX registers.
+	if (__builtin_cpu_supports("avx2"))
+		return SIMD_AVX2;
+	return SIMD_SSE;
+#endif
+}
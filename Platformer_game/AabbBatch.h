@@ -0,0 +1,49 @@
+#ifndef AABBBATCH_H_
+#define AABBBATCH_H_
+
+#include <vector>
+#include <cstdint>
+
+#include "SFML_includes.h"
+
+// Instruction sets of the batch collision kernel (selected at runtime by the CPU).
+enum SimdLevel : std::uint8_t
+{
+	SIMD_SCALAR = 0,
+	SIMD_SSE = 1,
+	SIMD_AVX2 = 2
+};
+
+// Axis aligned bounding boxes stored as structure of arrays (minimum and maximum of each axis),
+// one box is tested against all of them at once (narrow phase of the collisions).
+class AabbBatch
+{
+public:
+	// Borders of the boxes (absolute coordinates).
+	std::vector<float> minX_;
+	std::vector<float> minY_;
+	std::vector<float> maxX_;
+	std::vector<float> maxY_;
+
+	// Initial and setup functions:
+	AabbBatch();
+
+	void reserve(std::size_t capacity);
+	void resize(std::size_t size);
+	void clear();
+	void add(const sf::FloatRect& bounds);
+	void set(std::size_t index, const sf::FloatRect& bounds);
+
+	// Functions to obtain info about the boxes:
+	std::size_t size() const;
+
+	// Collision functions:
+	std::size_t findOverlaps(const sf::FloatRect& box, std::size_t first, std::size_t count,
+							std::vector<std::uint64_t>& mask) const;
+	std::size_t findOverlaps(const sf::FloatRect& box, std::size_t first, std::size_t count,
+							std::vector<std::uint64_t>& mask, SimdLevel level) const;
+
+	static SimdLevel getSupportedSimdLevel();
+};
+
+#endif
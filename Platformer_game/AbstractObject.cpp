@@ -22,11 +22,31 @@ void AbstractObject::move(sf::Vector2f distance)
 
 /// <summary>
 /// Sets position of the own window object (calls sf::setPosition function).
+/// The object is teleported -> it is not interpolated from the old position.
 /// </summary>
 /// <param name="newPos">New position.</param>
 void AbstractObject::setPos(sf::Vector2f newPos)
 {
     this->winObject_.setPosition(newPos);
+    this->previousPos_ = newPos;
+}
+
+/// <summary>
+/// Remembers the actual position as the position of the previous simulation tick.
+/// </summary>
+void AbstractObject::savePreviousPos()
+{
+    this->previousPos_ = this->winObject_.getPosition();
+}
+
+/// <summary>
+/// Computes where to draw the object between the previous and the actual tick.
+/// </summary>
+/// <param name="alpha">Part of the tick elapsed since the actual state (0 -> previous, 1 -> actual).</param>
+/// <returns>Returns offset of the interpolated position from the actual position.</returns>
+sf::Vector2f AbstractObject::getInterpolationOffset(float alpha)
+{
+    return (this->previousPos_ - this->winObject_.getPosition()) * (1.0f - alpha);
 }
 
 /// <summary>
@@ -9,6 +9,9 @@ public:
 	// Window object representation
 	sf::RectangleShape winObject_;
 
+	// Position at the start of the last simulation tick (for the render interpolation).
+	sf::Vector2f previousPos_;
+
 	// Initial and setup functions:
 	AbstractObject();
 	~AbstractObject();
@@ -16,6 +19,10 @@ public:
 	void move(sf::Vector2f distance);
 	void setPos(sf::Vector2f newPos);
 
+	// Render interpolation functions:
+	void savePreviousPos();
+	sf::Vector2f getInterpolationOffset(float alpha);
+
 	// Display function:
 	void drawTo(sf::RenderWindow& window);
 
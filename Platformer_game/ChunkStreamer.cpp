@@ -0,0 +1,497 @@
+#include "ChunkStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+// Public functions:
+
+/// <summary>
+/// Initializes the object (no chunk is loaded).
+/// </summary>
+/// <param name="tiles">Static level content.</param>
+/// <param name="obstacleSize">Size of the obstacle window objects (size of one cell).</param>
+/// <param name="coinSize">Size of the coin window objects.</param>
+ChunkStreamer::ChunkStreamer(std::shared_ptr<const TileGrid> tiles,
+							sf::Vector2f obstacleSize, sf::Vector2f coinSize)
+	: tiles_(std::move(tiles)), obstacleSize_(obstacleSize), coinSize_(coinSize)
+{
+	// Colors of the batched objects are same as colors of the window objects.
+	this->obstacleColor_ = Obstacle(obstacleSize).absObject_.winObject_.getFillColor();
+	this->finishColor_ = FinishLine(obstacleSize).absObject_.winObject_.getFillColor();
+	this->coinColor_ = Coin(coinSize).absObject_.winObject_.getFillColor();
+}
+
+/// <summary>
+/// Stops the background thread (if streaming).
+/// </summary>
+ChunkStreamer::~ChunkStreamer()
+{
+	if (this->worker_.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex_);
+			this->stopWorker_ = true;
+		}
+		this->condition_.notify_all();
+		this->worker_.join();
+	}
+}
+
+/// <summary>
+/// Builds all the chunks of the level at once (no streaming).
+/// Precomputed merged rectangles of the parsed level are used (no need to scan the grid),
+/// rectangles crossing chunk borders are split between the chunks.
+/// </summary>
+/// <param name="data">Parsed level.</param>
+void ChunkStreamer::loadAll(const LevelData& data)
+{
+	const int width = this->tiles_->getWidth();
+
+	// Obstacles
+	for (auto&& rectangle : data.solidRects_)
+	{
+		for (auto&& part : this->splitToChunks(rectangle))
+		{
+			auto& chunk = this->getOrCreateChunk(part.row / chunkSize_, part.column / chunkSize_);
+			this->appendQuad(chunk.staticBatch_, this->getRectangleBounds(part), this->obstacleColor_);
+		}
+	}
+
+	// Finish positions
+	for (auto&& rectangle : data.finishRects_)
+	{
+		for (auto&& part : this->splitToChunks(rectangle))
+		{
+			auto& chunk = this->getOrCreateChunk(part.row / chunkSize_, part.column / chunkSize_);
+			this->appendQuad(chunk.staticBatch_, this->getRectangleBounds(part), this->finishColor_);
+		}
+	}
+
+	// Coins (row-major order -> cells of each chunk are sorted)
+	for (auto cell : data.coinCells_)
+	{
+		int row = static_cast<int>(cell / width);
+		int column = static_cast<int>(cell % width);
+
+		auto& chunk = this->getOrCreateChunk(row / chunkSize_, column / chunkSize_);
+		this->appendQuad(chunk.coinBatch_, this->getCoinBounds(row, column), this->coinColor_);
+		chunk.coinCells_.push_back(cell);
+	}
+}
+
+/// <summary>
+/// Switches to the streaming mode (chunks are loaded on the background thread
+/// only around the center given in `update`).
+/// </summary>
+/// <param name="viewSize">Size of the displayed area (to choose how many chunks to load).</param>
+void ChunkStreamer::startStreaming(sf::Vector2f viewSize)
+{
+	if (this->streaming_)
+		return;
+
+	// Whole view and one chunk around it is loaded.
+	float halfViewCells = std::max(viewSize.x / this->obstacleSize_.x, viewSize.y / this->obstacleSize_.y) / 2;
+	this->loadRadius_ = static_cast<std::int64_t>(std::ceil(halfViewCells / chunkSize_)) + 1;
+
+	this->loadedChunks_.clear();
+	this->streaming_ = true;
+	this->worker_ = std::thread(&ChunkStreamer::runWorker, this);
+}
+
+/// <summary>
+/// Moves streaming center: takes over chunks built on the background thread,
+/// evicts far chunks and requests missing chunks (the nearest first).
+/// </summary>
+/// <param name="center">New center (absolute coordinates).</param>
+/// <param name="collectedCoins">Cell indices of the collected coins (sorted).</param>
+void ChunkStreamer::update(sf::Vector2f center, const std::vector<std::uint64_t>& collectedCoins)
+{
+	if (!this->streaming_)
+		return;
+
+	this->centerChunkRow_ = static_cast<std::int64_t>(
+				std::floor(center.y / this->obstacleSize_.y / chunkSize_));
+	this->centerChunkColumn_ = static_cast<std::int64_t>(
+				std::floor(center.x / this->obstacleSize_.x / chunkSize_));
+
+	// Take over built chunks.
+	std::vector<std::unique_ptr<LevelChunk>> builtChunks;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex_);
+		builtChunks.swap(this->builtChunks_);
+	}
+	for (auto&& chunk : builtChunks)
+	{
+		// Chunk could be built twice (requested during building).
+		if (this->loadedChunks_.find(chunk->key) != this->loadedChunks_.end())
+			continue;
+
+		// Hide coins collected before the chunk was loaded.
+		for (std::size_t i = 0; i < chunk->coinCells_.size(); i++)
+		{
+			if (std::binary_search(collectedCoins.begin(), collectedCoins.end(), chunk->coinCells_[i]))
+				this->setCoinVisible(*chunk, i, false);
+		}
+
+		this->loadedChunks_[chunk->key] = std::move(chunk);
+	}
+
+	// Evict chunks far from the center.
+	for (auto chunk = this->loadedChunks_.begin(); chunk != this->loadedChunks_.end();)
+	{
+		std::int64_t row = static_cast<std::int64_t>(chunk->first >> 32);
+		std::int64_t column = static_cast<std::int64_t>(chunk->first & 0xffffffffULL);
+
+		if (std::abs(row - this->centerChunkRow_) > this->loadRadius_ + 1 ||
+			std::abs(column - this->centerChunkColumn_) > this->loadRadius_ + 1)
+			chunk = this->loadedChunks_.erase(chunk);
+		else
+			chunk++;
+	}
+
+	// Find missing chunks around the center (sorted by distance).
+	const std::int64_t chunkRows = this->getChunkCount(this->tiles_->getHeight());
+	const std::int64_t chunkColumns = this->getChunkCount(this->tiles_->getWidth());
+
+	std::vector<std::pair<std::int64_t, std::uint64_t>> missingChunks;
+	for (std::int64_t row = this->centerChunkRow_ - this->loadRadius_;
+		row <= this->centerChunkRow_ + this->loadRadius_; row++)
+	{
+		for (std::int64_t column = this->centerChunkColumn_ - this->loadRadius_;
+			column <= this->centerChunkColumn_ + this->loadRadius_; column++)
+		{
+			if (row < 0 || row >= chunkRows || column < 0 || column >= chunkColumns)
+				continue;
+
+			auto key = getChunkKey(row, column);
+			if (this->loadedChunks_.find(key) == this->loadedChunks_.end())
+			{
+				auto distance = std::max(std::abs(row - this->centerChunkRow_),
+										std::abs(column - this->centerChunkColumn_));
+				missingChunks.push_back(std::make_pair(distance, key));
+			}
+		}
+	}
+	std::sort(missingChunks.begin(), missingChunks.end());
+
+	// Replace the requests (old requests are not needed anymore).
+	{
+		std::lock_guard<std::mutex> lock(this->mutex_);
+		this->requestedChunks_.clear();
+		for (auto&& missing : missingChunks)
+		{
+			if (!(this->building_ && this->buildingChunk_ == missing.second))
+				this->requestedChunks_.push_back(missing.second);
+		}
+	}
+	this->condition_.notify_one();
+}
+
+/// <summary>
+/// Hides collected coin in the loaded chunk (its quad is collapsed, the batch is not rebuilt).
+/// </summary>
+/// <param name="row">Relative row coordinate of the coin.</param>
+/// <param name="column">Relative column coordinate of the coin.</param>
+void ChunkStreamer::removeCoin(int row, int column)
+{
+	auto chunk = this->loadedChunks_.find(getChunkKey(row / chunkSize_, column / chunkSize_));
+	if (chunk == this->loadedChunks_.end())
+		return;
+
+	auto& cells = chunk->second->coinCells_;
+	auto cell = std::lower_bound(cells.begin(), cells.end(), this->tiles_->getIndex(row, column));
+	if (cell != cells.end() && *cell == this->tiles_->getIndex(row, column))
+		this->setCoinVisible(*chunk->second, static_cast<std::size_t>(cell - cells.begin()), false);
+}
+
+/// <summary>
+/// Shows all the coins of the loaded chunks again (new game).
+/// </summary>
+void ChunkStreamer::resetCoins()
+{
+	for (auto&& chunk : this->loadedChunks_)
+	{
+		for (std::size_t i = 0; i < chunk.second->coinCells_.size(); i++)
+		{
+			this->setCoinVisible(*chunk.second, i, true);
+		}
+	}
+}
+
+/// <summary>
+/// Adds quads of the loaded chunks overlapping the area to the batch (two batches per chunk).
+/// </summary>
+/// <param name="batch">Batch where to add the quads.</param>
+/// <param name="area">Displayed area (absolute coordinates).</param>
+void ChunkStreamer::addTo(SpriteBatch& batch, const sf::FloatRect& area)
+{
+	const float chunkWidth = this->obstacleSize_.x * chunkSize_;
+	const float chunkHeight = this->obstacleSize_.y * chunkSize_;
+
+	// Chunks overlapping the area (clipped to the map).
+	const std::int64_t firstRow = std::max<std::int64_t>(0, static_cast<std::int64_t>(std::floor(area.top / chunkHeight)));
+	const std::int64_t firstColumn = std::max<std::int64_t>(0, static_cast<std::int64_t>(std::floor(area.left / chunkWidth)));
+	const std::int64_t lastRow = std::min(this->getChunkCount(this->tiles_->getHeight()) - 1,
+					static_cast<std::int64_t>(std::floor((area.top + area.height) / chunkHeight)));
+	const std::int64_t lastColumn = std::min(this->getChunkCount(this->tiles_->getWidth()) - 1,
+					static_cast<std::int64_t>(std::floor((area.left + area.width) / chunkWidth)));
+
+	for (auto row = firstRow; row <= lastRow; row++)
+	{
+		for (auto column = firstColumn; column <= lastColumn; column++)
+		{
+			auto chunk = this->loadedChunks_.find(getChunkKey(row, column));
+			if (chunk == this->loadedChunks_.end())
+				continue;
+
+			// Obstacles and finish positions
+			batch.add(chunk->second->staticBatch_);
+
+			// Coins
+			batch.add(chunk->second->coinBatch_);
+		}
+	}
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns `true` if chunks are streamed, else `false` (all chunks loaded).</returns>
+bool ChunkStreamer::isStreaming()
+{
+	return this->streaming_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of chunks ready to be displayed.</returns>
+std::size_t ChunkStreamer::getLoadedChunkCount()
+{
+	return this->loadedChunks_.size();
+}
+
+/// <summary>
+/// Converts 2D chunk coordinates to 64-bit key.
+/// Convertion algorithm:		key = (chunkRow << 32) | chunkColumn
+/// </summary>
+/// <param name="chunkRow">Row of the chunk.</param>
+/// <param name="chunkColumn">Column of the chunk.</param>
+/// <returns>Returns key of the chunk.</returns>
+std::uint64_t ChunkStreamer::getChunkKey(std::int64_t chunkRow, std::int64_t chunkColumn)
+{
+	return (static_cast<std::uint64_t>(chunkRow) << 32) |
+			(static_cast<std::uint64_t>(chunkColumn) & 0xffffffffULL);
+}
+
+/// <summary>
+/// Finds the chunk containing the cell (in one direction).
+/// </summary>
+/// <param name="cell">Relative row or column coordinate (can be outside the map).</param>
+/// <returns>Returns row or column of the chunk.</returns>
+std::int64_t ChunkStreamer::getChunkIndex(int cell)
+{
+	// Floor division (cells outside the map can have negative coordinates).
+	return (cell >= 0) ? cell / chunkSize_ : (static_cast<std::int64_t>(cell) - chunkSize_ + 1) / chunkSize_;
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Main loop of the background thread (builds requested chunks until stopped).
+/// </summary>
+void ChunkStreamer::runWorker()
+{
+	while (true)
+	{
+		std::uint64_t key;
+		{
+			std::unique_lock<std::mutex> lock(this->mutex_);
+			this->condition_.wait(lock, [this]() {
+				return this->stopWorker_ || !this->requestedChunks_.empty(); });
+
+			if (this->stopWorker_)
+				return;
+
+			key = this->requestedChunks_.front();
+			this->requestedChunks_.pop_front();
+			this->building_ = true;
+			this->buildingChunk_ = key;
+		}
+
+		auto chunk = this->buildChunk(key);
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex_);
+			this->builtChunks_.push_back(std::move(chunk));
+			this->building_ = false;
+		}
+	}
+}
+
+/// <summary>
+/// Creates batches of the chunk from the tile grid.
+/// </summary>
+/// <param name="key">Key of the chunk to build.</param>
+/// <returns>Returns built chunk.</returns>
+std::unique_ptr<LevelChunk> ChunkStreamer::buildChunk(std::uint64_t key)
+{
+	std::unique_ptr<LevelChunk> chunk(new LevelChunk());
+	chunk->key = key;
+
+	const int firstRow = static_cast<int>(key >> 32) * chunkSize_;
+	const int firstColumn = static_cast<int>(key & 0xffffffffULL) * chunkSize_;
+	const int lastRow = std::min(firstRow + chunkSize_, this->tiles_->getHeight());
+	const int lastColumn = std::min(firstColumn + chunkSize_, this->tiles_->getWidth());
+
+	// Obstacles and finish positions are merged into rectangles (inside the chunk).
+	for (auto&& rectangle : this->tiles_->mergeRectangles(TILE_OBSTACLE, firstRow, firstColumn, chunkSize_, chunkSize_))
+	{
+		this->appendQuad(chunk->staticBatch_, this->getRectangleBounds(rectangle), this->obstacleColor_);
+	}
+	for (auto&& rectangle : this->tiles_->mergeRectangles(TILE_FINISH, firstRow, firstColumn, chunkSize_, chunkSize_))
+	{
+		this->appendQuad(chunk->staticBatch_, this->getRectangleBounds(rectangle), this->finishColor_);
+	}
+
+	// Coins
+	for (int row = firstRow; row < lastRow; row++)
+	{
+		for (int column = firstColumn; column < lastColumn; column++)
+		{
+			if (this->tiles_->hasFlag(row, column, TILE_COIN))
+			{
+				this->appendQuad(chunk->coinBatch_, this->getCoinBounds(row, column), this->coinColor_);
+				chunk->coinCells_.push_back(this->tiles_->getIndex(row, column));
+			}
+		}
+	}
+
+	return chunk;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="row">Row of the chunk.</param>
+/// <param name="column">Column of the chunk.</param>
+/// <returns>Returns loaded chunk on the given coordinates (creates empty one if missing).</returns>
+LevelChunk& ChunkStreamer::getOrCreateChunk(std::int64_t row, std::int64_t column)
+{
+	auto key = getChunkKey(row, column);
+	auto& chunk = this->loadedChunks_[key];
+	if (!chunk)
+	{
+		chunk.reset(new LevelChunk());
+		chunk->key = key;
+	}
+
+	return *chunk;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="cells">Number of cells.</param>
+/// <returns>Returns number of chunks needed to cover given number of cells.</returns>
+std::int64_t ChunkStreamer::getChunkCount(int cells)
+{
+	return (static_cast<std::int64_t>(cells) + chunkSize_ - 1) / chunkSize_;
+}
+
+/// <summary>
+/// Converts relative coordinates to absolute (in window sizes).
+/// </summary>
+/// <param name="row">Row coordinate to convert.</param>
+/// <param name="column">Column coordinate to convert.</param>
+/// <returns>Returns 2D absolute coordinates of the given relative coordinates {column, row}.</returns>
+sf::Vector2f ChunkStreamer::convertRelToAbsoluteCoord(int row, int column)
+{
+	return { column * this->obstacleSize_.x, row * this->obstacleSize_.y };
+}
+
+/// <summary>
+/// Splits the rectangle into parts lying each in one chunk.
+/// </summary>
+/// <param name="rectangle">Rectangle to split (relative coordinates).</param>
+/// <returns>Returns parts of the rectangle (one for each chunk it crosses).</returns>
+std::vector<TileRect> ChunkStreamer::splitToChunks(const TileRect& rectangle)
+{
+	std::vector<TileRect> parts;
+
+	const int lastRow = rectangle.row + rectangle.rows;
+	const int lastColumn = rectangle.column + rectangle.columns;
+
+	for (int row = rectangle.row; row < lastRow; row = (row / chunkSize_ + 1) * chunkSize_)
+	{
+		for (int column = rectangle.column; column < lastColumn; column = (column / chunkSize_ + 1) * chunkSize_)
+		{
+			TileRect part;
+			part.row = row;
+			part.column = column;
+			part.rows = std::min((row / chunkSize_ + 1) * chunkSize_, lastRow) - row;
+			part.columns = std::min((column / chunkSize_ + 1) * chunkSize_, lastColumn) - column;
+			parts.push_back(part);
+		}
+	}
+
+	return parts;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="rectangle">Rectangle of the cells.</param>
+/// <returns>Returns absolute bounds of the rectangle.</returns>
+sf::FloatRect ChunkStreamer::getRectangleBounds(const TileRect& rectangle)
+{
+	return sf::FloatRect(this->convertRelToAbsoluteCoord(rectangle.row, rectangle.column),
+		sf::Vector2f(rectangle.columns * this->obstacleSize_.x, rectangle.rows * this->obstacleSize_.y));
+}
+
+/// <summary>
+/// </summary>
+/// <param name="row">Relative row coordinate of the coin.</param>
+/// <param name="column">Relative column coordinate of the coin.</param>
+/// <returns>Returns absolute bounds of the coin.</returns>
+sf::FloatRect ChunkStreamer::getCoinBounds(int row, int column)
+{
+	return sf::FloatRect(this->convertRelToAbsoluteCoord(row, column), this->coinSize_);
+}
+
+/// <summary>
+/// Appends one quad (4 vertices) to the batch.
+/// </summary>
+/// <param name="batch">Batch where to add the quad.</param>
+/// <param name="bounds">Absolute bounds of the quad.</param>
+/// <param name="color">Color of the quad.</param>
+void ChunkStreamer::appendQuad(sf::VertexArray& batch, const sf::FloatRect& bounds, sf::Color color)
+{
+	batch.append(sf::Vertex({ bounds.left, bounds.top }, color));
+	batch.append(sf::Vertex({ bounds.left + bounds.width, bounds.top }, color));
+	batch.append(sf::Vertex({ bounds.left + bounds.width, bounds.top + bounds.height }, color));
+	batch.append(sf::Vertex({ bounds.left, bounds.top + bounds.height }, color));
+}
+
+/// <summary>
+/// Shows or hides the coin quad in the batch (hidden quad is collapsed to one point).
+/// </summary>
+/// <param name="chunk">Chunk containing the coin.</param>
+/// <param name="coin">Index of the coin in the chunk.</param>
+/// <param name="visible">Should be the coin visible.</param>
+void ChunkStreamer::setCoinVisible(LevelChunk& chunk, std::size_t coin, bool visible)
+{
+	const auto cell = chunk.coinCells_[coin];
+	const int width = this->tiles_->getWidth();
+	const auto bounds = this->getCoinBounds(static_cast<int>(cell / width), static_cast<int>(cell % width));
+
+	sf::Vertex* quad = &chunk.coinBatch_[coin * 4];
+	quad[0].position = { bounds.left, bounds.top };
+	quad[1].position = quad[0].position;
+	quad[2].position = quad[0].position;
+	quad[3].position = quad[0].position;
+
+	if (visible)
+	{
+		quad[1].position.x += bounds.width;
+		quad[2].position += { bounds.width, bounds.height };
+		quad[3].position.y += bounds.height;
+	}
+}
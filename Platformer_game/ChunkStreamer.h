@@ -0,0 +1,122 @@
+#ifndef CHUNKSTREAMER_H_
+#define CHUNKSTREAMER_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "SFML_includes.h"
+#include "Obstacle.h"
+#include "Coin.h"
+#include "FinishLine.h"
+#include "TileGrid.h"
+#include "LevelData.h"
+#include "SpriteBatch.h"
+
+// Batched window objects of one square part of the map (`chunkSize_` x `chunkSize_` cells).
+struct LevelChunk
+{
+	std::uint64_t key = 0;
+
+	// Obstacles and finish positions merged into rectangles (one quad per rectangle).
+	sf::VertexArray staticBatch_ = sf::VertexArray(sf::Quads);
+
+	// One quad per coin (collected coins are collapsed, the batch is not rebuilt).
+	sf::VertexArray coinBatch_ = sf::VertexArray(sf::Quads);
+	// Cell index of each coin quad (sorted).
+	std::vector<std::uint64_t> coinCells_;
+};
+
+// Manages batched window objects of the static level content split into chunks.
+// In streaming mode only chunks around the view center are kept in the memory,
+// they are built on the background thread and evicted when the view moves away.
+// Only the window objects are streamed: the tile grid they are built from (one byte per cell,
+// needed by the collisions of all the active objects) stays resident for the whole map.
+class ChunkStreamer
+{
+public:
+	// Number of cells in each direction of one chunk.
+	static const int chunkSize_ = 32;
+
+	// Initial and setup functions:
+	ChunkStreamer(std::shared_ptr<const TileGrid> tiles, sf::Vector2f obstacleSize, sf::Vector2f coinSize);
+	~ChunkStreamer();
+
+	ChunkStreamer(const ChunkStreamer&) = delete;
+	ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+	void loadAll(const LevelData& data);
+	void startStreaming(sf::Vector2f viewSize);
+
+	// Update functions:
+	void update(sf::Vector2f center, const std::vector<std::uint64_t>& collectedCoins);
+	void removeCoin(int row, int column);
+	void resetCoins();
+
+	// Display function:
+	void addTo(SpriteBatch& batch, const sf::FloatRect& area);
+
+	// Functions to obtain info about the chunks:
+	bool isStreaming();
+	std::size_t getLoadedChunkCount();
+
+	static std::uint64_t getChunkKey(std::int64_t chunkRow, std::int64_t chunkColumn);
+	static std::int64_t getChunkIndex(int cell);
+
+private:
+	// Static level content (read only, shared with the background thread).
+	std::shared_ptr<const TileGrid> tiles_;
+
+	// Sizes of the level objects:
+	sf::Vector2f obstacleSize_;
+	sf::Vector2f coinSize_;
+
+	// Colors of the batched objects:
+	sf::Color obstacleColor_;
+	sf::Color finishColor_;
+	sf::Color coinColor_;
+
+	// Streaming setup:
+	bool streaming_ = false;
+	// Chunks closer than `loadRadius_` (in chunks) to the center are loaded,
+	// chunks further than `loadRadius_ + 1` are evicted.
+	std::int64_t loadRadius_ = 1;
+	std::int64_t centerChunkRow_ = 0;
+	std::int64_t centerChunkColumn_ = 0;
+
+	// Chunks ready to be displayed (used only by the main thread).
+	std::unordered_map<std::uint64_t, std::unique_ptr<LevelChunk>> loadedChunks_;
+
+	// Background thread variables (guarded by `mutex_`):
+	std::thread worker_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	std::deque<std::uint64_t> requestedChunks_;
+	std::vector<std::unique_ptr<LevelChunk>> builtChunks_;
+	std::uint64_t buildingChunk_ = 0;
+	bool building_ = false;
+	bool stopWorker_ = false;
+
+	// Chunk building functions:
+	void runWorker();
+	std::unique_ptr<LevelChunk> buildChunk(std::uint64_t key);
+	LevelChunk& getOrCreateChunk(std::int64_t row, std::int64_t column);
+	std::vector<TileRect> splitToChunks(const TileRect& rectangle);
+
+	// Coordinates conversion:
+	std::int64_t getChunkCount(int cells);
+	sf::Vector2f convertRelToAbsoluteCoord(int row, int column);
+	sf::FloatRect getRectangleBounds(const TileRect& rectangle);
+	sf::FloatRect getCoinBounds(int row, int column);
+
+	// Batch functions:
+	void appendQuad(sf::VertexArray& batch, const sf::FloatRect& bounds, sf::Color color);
+	void setCoinVisible(LevelChunk& chunk, std::size_t coin, bool visible);
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "ColliderGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+ColliderGrid::ColliderGrid() {}
+
+/// <summary>
+/// Rebuilds the grid from the merged rectangles (memory is kept for the next build).
+/// </summary>
+/// <param name="rectangles">Merged rectangles of the obstacles (relative coordinates, inside the map).</param>
+/// <param name="width">Width of the map (in cells).</param>
+/// <param name="height">Height of the map (in cells).</param>
+/// <param name="cellSize">Size of one cell (in absolute coordinates).</param>
+void ColliderGrid::build(const std::vector<TileRect>& rectangles, int width, int height, sf::Vector2f cellSize)
+{
+	this->cellSize_ = cellSize;
+	this->rectangles_ = rectangles;
+	this->blockColumns_ = (std::max(width, 0) + blockSize_ - 1) / blockSize_;
+	this->blockRows_ = (std::max(height, 0) + blockSize_ - 1) / blockSize_;
+
+	// Counting sort of the rectangles to the blocks they overlap.
+	const std::size_t blockCount = static_cast<std::size_t>(this->blockColumns_) * this->blockRows_;
+	this->blockStarts_.assign(blockCount + 1, 0);
+	for (int pass = 0; pass < 2; pass++)
+	{
+		if (pass == 1)
+		// Block sizes counted -> starts of the blocks (`blockStarts_[block]` is then used as the next free entry).
+		{
+			for (std::size_t block = 0; block < blockCount; block++)
+			{
+				this->blockStarts_[block + 1] += this->blockStarts_[block];
+			}
+			this->entries_.resize(this->blockStarts_[blockCount]);
+		}
+
+		for (std::size_t i = 0; i < this->rectangles_.size(); i++)
+		{
+			const TileRect& rectangle = this->rectangles_[i];
+			for (int blockRow = rectangle.row / blockSize_;
+				blockRow <= (rectangle.row + rectangle.rows - 1) / blockSize_; blockRow++)
+			{
+				for (int blockColumn = rectangle.column / blockSize_;
+					blockColumn <= (rectangle.column + rectangle.columns - 1) / blockSize_; blockColumn++)
+				{
+					const std::size_t block = static_cast<std::size_t>(blockRow) * this->blockColumns_ + blockColumn;
+					if (pass == 0)
+						this->blockStarts_[block + 1]++;
+					else
+						this->entries_[this->blockStarts_[block]++] = static_cast<std::uint32_t>(i);
+				}
+			}
+		}
+	}
+
+	// Restore the starts of the blocks.
+	for (std::size_t block = blockCount; block > 0; block--)
+	{
+		this->blockStarts_[block] = this->blockStarts_[block - 1];
+	}
+	this->blockStarts_[0] = 0;
+}
+
+/// <summary>
+/// Checks whether the bounding box overlaps some obstacle (touching boxes do not overlap).
+/// </summary>
+/// <param name="bounds">Bounding box to check (absolute coordinates).</param>
+/// <returns>Returns `true` if the box overlaps some obstacle, else `false`.</returns>
+bool ColliderGrid::checkOverlap(const sf::FloatRect& bounds) const
+{
+	// Cells around the box (one more on each side, the exact test is done with the rectangles).
+	int firstBlockRow, firstBlockColumn, lastBlockRow, lastBlockColumn;
+	if (!this->getBlockRange(static_cast<int>(std::floor(bounds.top / this->cellSize_.y)) - 1,
+							static_cast<int>(std::floor(bounds.left / this->cellSize_.x)) - 1,
+							static_cast<int>(std::floor((bounds.top + bounds.height) / this->cellSize_.y)),
+							static_cast<int>(std::floor((bounds.left + bounds.width) / this->cellSize_.x)),
+							firstBlockRow, firstBlockColumn, lastBlockRow, lastBlockColumn))
+		return false;
+
+	for (int blockRow = firstBlockRow; blockRow <= lastBlockRow; blockRow++)
+	{
+		for (int blockColumn = firstBlockColumn; blockColumn <= lastBlockColumn; blockColumn++)
+		{
+			const std::size_t block = static_cast<std::size_t>(blockRow) * this->blockColumns_ + blockColumn;
+			for (std::uint32_t entry = this->blockStarts_[block]; entry < this->blockStarts_[block + 1]; entry++)
+			{
+				const TileRect& rectangle = this->rectangles_[this->entries_[entry]];
+				const sf::FloatRect rectangleBounds(rectangle.column * this->cellSize_.x, rectangle.row * this->cellSize_.y,
+													rectangle.columns * this->cellSize_.x, rectangle.rows * this->cellSize_.y);
+				if (bounds.intersects(rectangleBounds))
+					return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/// <summary>
+/// Finds the nearest line of the cells containing some obstacle in the given area.
+/// Lines are rows (vertical search) or columns (horizontal search) from `firstLine` towards `lastLine`,
+/// only cells from `firstAcross` to `lastAcross` of each line are checked.
+/// </summary>
+/// <param name="horizontal">Are the lines columns (yes - `true`, no - `false`).</param>
+/// <param name="firstAcross">First checked cell of each line.</param>
+/// <param name="lastAcross">Last checked cell of each line.</param>
+/// <param name="step">Direction of the search (`1` -> increasing lines, `-1` -> decreasing lines).</param>
+/// <param name="firstLine">Nearest line (searched first).</param>
+/// <param name="lastLine">Farthest line (no line is searched if it is behind `firstLine`).</param>
+/// <param name="line">Found line.</param>
+/// <returns>Returns `true` if some line contains an obstacle, else `false`.</returns>
+bool ColliderGrid::findNearestLine(bool horizontal, int firstAcross, int lastAcross,
+									int step, int firstLine, int lastLine, int& line) const
+{
+	if ((lastLine - firstLine) * step < 0)
+		return false;
+
+	const int minLine = std::min(firstLine, lastLine);
+	const int maxLine = std::max(firstLine, lastLine);
+
+	int firstBlockRow, firstBlockColumn, lastBlockRow, lastBlockColumn;
+	if (!(horizontal ? this->getBlockRange(firstAcross, minLine, lastAcross, maxLine,
+										firstBlockRow, firstBlockColumn, lastBlockRow, lastBlockColumn)
+					: this->getBlockRange(minLine, firstAcross, maxLine, lastAcross,
+										firstBlockRow, firstBlockColumn, lastBlockRow, lastBlockColumn)))
+		return false;
+
+	bool found = false;
+	for (int blockRow = firstBlockRow; blockRow <= lastBlockRow; blockRow++)
+	{
+		for (int blockColumn = firstBlockColumn; blockColumn <= lastBlockColumn; blockColumn++)
+		{
+			const std::size_t block = static_cast<std::size_t>(blockRow) * this->blockColumns_ + blockColumn;
+			for (std::uint32_t entry = this->blockStarts_[block]; entry < this->blockStarts_[block + 1]; entry++)
+			{
+				const TileRect& rectangle = this->rectangles_[this->entries_[entry]];
+				const int rectangleFirstAcross = horizontal ? rectangle.row : rectangle.column;
+				const int rectangleLastAcross = rectangleFirstAcross + (horizontal ? rectangle.rows : rectangle.columns) - 1;
+				const int rectangleFirstLine = horizontal ? rectangle.column : rectangle.row;
+				const int rectangleLastLine = rectangleFirstLine + (horizontal ? rectangle.columns : rectangle.rows) - 1;
+				if (rectangleLastAcross < firstAcross || rectangleFirstAcross > lastAcross ||
+					rectangleLastLine < minLine || rectangleFirstLine > maxLine)
+					continue;
+
+				// Line of the rectangle nearest to the `firstLine`.
+				const int nearestLine = (step > 0) ? std::max(rectangleFirstLine, firstLine)
+												: std::min(rectangleLastLine, firstLine);
+				if (!found || (nearestLine - line) * step < 0)
+				{
+					line = nearestLine;
+					found = true;
+				}
+			}
+		}
+	}
+
+	return found;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the merged rectangles.</returns>
+std::size_t ColliderGrid::getRectangleCount() const
+{
+	return this->rectangles_.size();
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Finds the blocks covering the area of the cells (clipped to the map).
+/// </summary>
+/// <param name="firstRow">Top row of the area.</param>
+/// <param name="firstColumn">Left column of the area.</param>
+/// <param name="lastRow">Bottom row of the area.</param>
+/// <param name="lastColumn">Right column of the area.</param>
+/// <param name="firstBlockRow">Top row of the blocks.</param>
+/// <param name="firstBlockColumn">Left column of the blocks.</param>
+/// <param name="lastBlockRow">Bottom row of the blocks.</param>
+/// <param name="lastBlockColumn">Right column of the blocks.</param>
+/// <returns>Returns `true` if the area overlaps the map, else `false`.</returns>
+bool ColliderGrid::getBlockRange(int firstRow, int firstColumn, int lastRow, int lastColumn,
+								int& firstBlockRow, int& firstBlockColumn, int& lastBlockRow, int& lastBlockColumn) const
+{
+	if (lastRow < 0 || lastColumn < 0 || firstRow > lastRow || firstColumn > lastColumn)
+		return false;
+
+	firstBlockRow = std::max(firstRow, 0) / blockSize_;
+	firstBlockColumn = std::max(firstColumn, 0) / blockSize_;
+	lastBlockRow = std::min(lastRow / blockSize_, this->blockRows_ - 1);
+	lastBlockColumn = std::min(lastColumn / blockSize_, this->blockColumns_ - 1);
+
+	return firstBlockRow <= lastBlockRow && firstBlockColumn <= lastBlockColumn;
+}
@@ -0,0 +1,51 @@
+#ifndef COLLIDERGRID_H_
+#define COLLIDERGRID_H_
+
+#include <vector>
+#include <cstdint>
+
+#include "SFML_includes.h"
+#include "TileGrid.h"
+
+// Merged obstacle rectangles of the level (static colliders) bucketed by square blocks of the cells.
+// Built once per level, each rectangle is stored in all the blocks it overlaps (counting sort, one array),
+// so a query tests only the few rectangles around the queried area instead of each cell.
+// The grid is never changed by the queries (can be queried from more threads at once).
+class ColliderGrid
+{
+public:
+	// Initial and setup functions:
+	ColliderGrid();
+
+	void build(const std::vector<TileRect>& rectangles, int width, int height, sf::Vector2f cellSize);
+
+	// Query functions:
+	bool checkOverlap(const sf::FloatRect& bounds) const;
+	bool findNearestLine(bool horizontal, int firstAcross, int lastAcross,
+						int step, int firstLine, int lastLine, int& line) const;
+
+	// Functions to obtain info about the grid:
+	std::size_t getRectangleCount() const;
+
+private:
+	// Size of one block (in cells).
+	static const int blockSize_ = 8;
+
+	// Size of one cell (in absolute coordinates).
+	sf::Vector2f cellSize_ = { 1.0f, 1.0f };
+
+	// Number of the blocks in each direction.
+	int blockColumns_ = 0;
+	int blockRows_ = 0;
+
+	std::vector<TileRect> rectangles_;
+	// Rectangles of each block are `rectangles_[entries_[blockStarts_[block]]]` ..
+	// `rectangles_[entries_[blockStarts_[block + 1] - 1]]` (row-major order of the blocks).
+	std::vector<std::uint32_t> blockStarts_;
+	std::vector<std::uint32_t> entries_;
+
+	bool getBlockRange(int firstRow, int firstColumn, int lastRow, int lastColumn,
+						int& firstBlockRow, int& firstBlockColumn, int& lastBlockRow, int& lastBlockColumn) const;
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include "EntityGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+EntityGrid::EntityGrid() {}
+
+/// <summary>
+/// Initializes empty grid.
+/// </summary>
+/// <param name="cellSize">Size of one cell (in absolute coordinates).</param>
+EntityGrid::EntityGrid(sf::Vector2f cellSize)
+	: cellSize_(cellSize)
+{
+}
+
+/// <summary>
+/// Rebuilds the grid, each entity is added to all the cells its bounding box overlaps
+/// (memory is kept for the next build).
+/// </summary>
+/// <param name="entities">Entities to add (identifiers are their indices).</param>
+void EntityGrid::build(const EntityStore& entities)
+{
+	// Cells of all the entities.
+	this->unsortedEntries_.clear();
+	for (std::size_t i = 0; i < entities.size(); i++)
+	{
+		const sf::IntRect cells = this->getCellRange(entities.getBounds(i));
+		for (int row = cells.top; row < cells.top + cells.height; row++)
+		{
+			for (int column = cells.left; column < cells.left + cells.width; column++)
+			{
+				GridEntry entry;
+				entry.cell = getCellKey(row, column);
+				entry.entity = static_cast<std::uint32_t>(i);
+				this->unsortedEntries_.push_back(entry);
+			}
+		}
+	}
+
+	// Number of the buckets is a power of two (at least two buckets per entry).
+	std::size_t bucketCount = 16;
+	while (bucketCount < 2 * this->unsortedEntries_.size())
+	{
+		bucketCount *= 2;
+	}
+	this->bucketMask_ = bucketCount - 1;
+
+	// Counting sort to the buckets (entities stay sorted inside each bucket).
+	this->bucketStarts_.assign(bucketCount + 1, 0);
+	for (auto&& entry : this->unsortedEntries_)
+	{
+		this->bucketStarts_[this->getBucket(entry.cell) + 1]++;
+	}
+	for (std::size_t bucket = 0; bucket < bucketCount; bucket++)
+	{
+		this->bucketStarts_[bucket + 1] += this->bucketStarts_[bucket];
+	}
+
+	this->entries_.resize(this->unsortedEntries_.size());
+	this->boxes_.resize(this->unsortedEntries_.size());
+	for (auto&& entry : this->unsortedEntries_)
+	{
+		// `bucketStarts_[bucket]` is used as the next free entry of the bucket and restored below.
+		const std::uint32_t position = this->bucketStarts_[this->getBucket(entry.cell)]++;
+		this->entries_[position] = entry;
+		this->boxes_.set(position, entities.getBounds(entry.entity));
+	}
+	for (std::size_t bucket = bucketCount; bucket > 0; bucket--)
+	{
+		this->bucketStarts_[bucket] = this->bucketStarts_[bucket - 1];
+	}
+	this->bucketStarts_[0] = 0;
+}
+
+/// <summary>
+/// Finds all the entities overlapping the area (touching entities do not overlap).
+/// Bounding boxes of each bucket of the cells overlapping the area are tested at once.
+/// Can be called from more threads at once (the grid is not changed).
+/// </summary>
+/// <param name="area">Area to search (absolute coordinates, positive size).</param>
+/// <param name="query">Buffers of the query, `query.result` are found indices of the entities (sorted, without duplicates).</param>
+void EntityGrid::query(const sf::FloatRect& area, GridQuery& query) const
+{
+	std::vector<std::uint32_t>& result = query.result;
+	result.clear();
+	if (this->entries_.empty())
+		return;
+
+	const sf::IntRect cells = this->getCellRange(area);
+	for (int row = cells.top; row < cells.top + cells.height; row++)
+	{
+		for (int column = cells.left; column < cells.left + cells.width; column++)
+		{
+			const std::size_t bucket = this->getBucket(getCellKey(row, column));
+			const std::uint32_t first = this->bucketStarts_[bucket];
+			const std::uint32_t count = this->bucketStarts_[bucket + 1] - first;
+			// Entries of other cells sharing the bucket are tested too (hits are still correct).
+			if (count == 0 || this->boxes_.findOverlaps(area, first, count, query.hitMask) == 0)
+				continue;
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				if (query.hitMask[i / 64] & (std::uint64_t(1) << (i % 64)))
+					result.push_back(this->entries_[first + i].entity);
+			}
+		}
+	}
+
+	// Entities overlapping more cells (or sharing more buckets) are found more times.
+	if (result.size() > 1)
+	{
+		std::sort(result.begin(), result.end());
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+	}
+}
+
+/// <summary>
+/// </summary>
+/// <param name="area">Area (absolute coordinates).</param>
+/// <returns>Returns cells overlapping the area (left top cell {column, row} and number of the cells).</returns>
+sf::IntRect EntityGrid::getCellRange(const sf::FloatRect& area) const
+{
+	const int firstRow = static_cast<int>(std::floor(area.top / this->cellSize_.y));
+	const int lastRow = static_cast<int>(std::floor((area.top + area.height) / this->cellSize_.y));
+	const int firstColumn = static_cast<int>(std::floor(area.left / this->cellSize_.x));
+	const int lastColumn = static_cast<int>(std::floor((area.left + area.width) / this->cellSize_.x));
+
+	return sf::IntRect(firstColumn, firstRow, lastColumn - firstColumn + 1, lastRow - firstRow + 1);
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the entries (one per entity and overlapped cell).</returns>
+std::size_t EntityGrid::getEntryCount() const
+{
+	return this->entries_.size();
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Converts 2D cell coordinates to 64-bit key.
+/// Convertion algorithm:		key = (row << 32) | column
+/// </summary>
+/// <param name="row">Row of the cell.</param>
+/// <param name="column">Column of the cell.</param>
+/// <returns>Returns key of the cell.</returns>
+std::uint64_t EntityGrid::getCellKey(int row, int column)
+{
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(row)) << 32) |
+			static_cast<std::uint64_t>(static_cast<std::uint32_t>(column));
+}
+
+/// <summary>
+/// </summary>
+/// <param name="cell">Key of the cell.</param>
+/// <returns>Returns hash bucket of the cell (Fibonacci hashing).</returns>
+std::size_t EntityGrid::getBucket(std::uint64_t cell) const
+{
+	return static_cast<std::size_t>(((cell * 0x9E3779B97F4A7C15ULL) >> 32) & this->bucketMask_);
+}
@@ -0,0 +1,65 @@
+#ifndef ENTITYGRID_H_
+#define ENTITYGRID_H_
+
+#include <vector>
+#include <cstdint>
+
+#include "SFML_includes.h"
+#include "EntityStore.h"
+#include "AabbBatch.h"
+
+// One entity in one cell of the `EntityGrid`.
+struct GridEntry
+{
+	std::uint64_t cell = 0;
+	std::uint32_t entity = 0;
+};
+
+// Buffers of the grid query (each thread querying the grid at the same time needs its own).
+struct GridQuery
+{
+	// Found indices of the entities.
+	std::vector<std::uint32_t> result;
+	// Hits of the last batch test.
+	std::vector<std::uint64_t> hitMask;
+};
+
+// Spatial hash of the entities (broadphase of the collisions between the moving objects).
+// The grid is rebuilt from the actual bounding boxes (e.g. once per tick), entries are stored
+// in one array sorted by the hash buckets (counting sort, no allocation per cell).
+// Bounding boxes of the entries are stored in the same order, so each bucket is tested by one batch test.
+class EntityGrid
+{
+public:
+	// Initial and setup functions:
+	EntityGrid();
+	explicit EntityGrid(sf::Vector2f cellSize);
+
+	void build(const EntityStore& entities);
+
+	// Query function:
+	void query(const sf::FloatRect& area, GridQuery& query) const;
+
+	// Functions to obtain info about the grid:
+	sf::IntRect getCellRange(const sf::FloatRect& area) const;
+	std::size_t getEntryCount() const;
+
+private:
+	// Size of one cell (in absolute coordinates).
+	sf::Vector2f cellSize_ = { 1.0f, 1.0f };
+
+	// Entries of each bucket are `entries_[bucketStarts_[bucket]]` .. `entries_[bucketStarts_[bucket + 1] - 1]`.
+	std::vector<std::uint32_t> bucketStarts_;
+	std::vector<GridEntry> entries_;
+	// Bounding box of the entity of each entry.
+	AabbBatch boxes_;
+	// Entries in the order of the entities (before sorting to the buckets).
+	std::vector<GridEntry> unsortedEntries_;
+	std::uint64_t bucketMask_ = 0;
+
+	// Cell functions:
+	static std::uint64_t getCellKey(int row, int column);
+	std::size_t getBucket(std::uint64_t cell) const;
+};
+
+#endif
@@ -0,0 +1,272 @@
+#include "EntityStore.h"
+
+EntityStore::EntityStore() {}
+
+/// <summary>
+/// Preallocates memory of all the components (no reallocation until the capacity is reached).
+/// </summary>
+/// <param name="capacity">Number of the entities.</param>
+void EntityStore::reserve(std::size_t capacity)
+{
+	this->positionX_.reserve(capacity);
+	this->positionY_.reserve(capacity);
+	this->halfExtentX_.reserve(capacity);
+	this->halfExtentY_.reserve(capacity);
+	this->velocityX_.reserve(capacity);
+	this->velocityY_.reserve(capacity);
+	this->orientation_.reserve(capacity);
+	this->flags_.reserve(capacity);
+	this->previousX_.reserve(capacity);
+	this->previousY_.reserve(capacity);
+
+	this->slots_.reserve(capacity);
+	this->slotIndices_.reserve(capacity);
+	this->slotGenerations_.reserve(capacity);
+	this->freeSlots_.reserve(capacity);
+}
+
+/// <summary>
+/// Removes all the entities (memory is kept, all the handles become invalid).
+/// </summary>
+void EntityStore::clear()
+{
+	while (!this->empty())
+	{
+		this->remove(this->size() - 1);
+	}
+}
+
+/// <summary>
+/// Adds new entity to the end of the component arrays.
+/// </summary>
+/// <param name="position">Left top corner of the bounding box.</param>
+/// <param name="halfExtent">Half of the bounding box size.</param>
+/// <param name="velocity">Speed of the entity.</param>
+/// <param name="orientation">Orientation of the entity (`EntityOrientation` value).</param>
+/// <param name="flags">Flags of the entity (`EntityFlag` bit mask).</param>
+/// <returns>Returns handle of the new entity.</returns>
+EntityHandle EntityStore::add(sf::Vector2f position, sf::Vector2f halfExtent, sf::Vector2f velocity,
+								std::uint8_t orientation, std::uint8_t flags)
+{
+	const std::uint32_t index = static_cast<std::uint32_t>(this->size());
+
+	std::uint32_t slot;
+	if (!this->freeSlots_.empty())
+	// Reuse slot of the removed entity.
+	{
+		slot = this->freeSlots_.back();
+		this->freeSlots_.pop_back();
+		this->slotIndices_[slot] = index;
+	}
+	else
+	{
+		slot = static_cast<std::uint32_t>(this->slotIndices_.size());
+		this->slotIndices_.push_back(index);
+		this->slotGenerations_.push_back(0);
+	}
+	this->slots_.push_back(slot);
+
+	this->positionX_.push_back(position.x);
+	this->positionY_.push_back(position.y);
+	this->halfExtentX_.push_back(halfExtent.x);
+	this->halfExtentY_.push_back(halfExtent.y);
+	this->velocityX_.push_back(velocity.x);
+	this->velocityY_.push_back(velocity.y);
+	this->orientation_.push_back(orientation);
+	this->flags_.push_back(flags);
+	this->previousX_.push_back(position.x);
+	this->previousY_.push_back(position.y);
+
+	EntityHandle handle;
+	handle.slot = slot;
+	handle.generation = this->slotGenerations_[slot];
+	return handle;
+}
+
+/// <summary>
+/// Removes the entity, the last entity is moved to its place (swap-remove).
+/// Iterating loops should not move to the next index after the removal.
+/// </summary>
+/// <param name="index">Index of the entity to remove.</param>
+void EntityStore::remove(std::size_t index)
+{
+	const std::size_t last = this->size() - 1;
+	const std::uint32_t slot = this->slots_[index];
+
+	if (index != last)
+	// Move the last entity to the place of the removed one.
+	{
+		this->positionX_[index] = this->positionX_[last];
+		this->positionY_[index] = this->positionY_[last];
+		this->halfExtentX_[index] = this->halfExtentX_[last];
+		this->halfExtentY_[index] = this->halfExtentY_[last];
+		this->velocityX_[index] = this->velocityX_[last];
+		this->velocityY_[index] = this->velocityY_[last];
+		this->orientation_[index] = this->orientation_[last];
+		this->flags_[index] = this->flags_[last];
+		this->previousX_[index] = this->previousX_[last];
+		this->previousY_[index] = this->previousY_[last];
+
+		this->slots_[index] = this->slots_[last];
+		this->slotIndices_[this->slots_[index]] = static_cast<std::uint32_t>(index);
+	}
+
+	this->positionX_.pop_back();
+	this->positionY_.pop_back();
+	this->halfExtentX_.pop_back();
+	this->halfExtentY_.pop_back();
+	this->velocityX_.pop_back();
+	this->velocityY_.pop_back();
+	this->orientation_.pop_back();
+	this->flags_.pop_back();
+	this->previousX_.pop_back();
+	this->previousY_.pop_back();
+	this->slots_.pop_back();
+
+	// Old handles of the slot become invalid.
+	this->slotGenerations_[slot]++;
+	this->freeSlots_.push_back(slot);
+}
+
+/// <summary>
+/// Removes the entity referenced by the handle.
+/// </summary>
+/// <param name="handle">Handle of the entity.</param>
+/// <returns>Returns `true` if the entity was removed, else `false` (entity already removed).</returns>
+bool EntityStore::remove(EntityHandle handle)
+{
+	if (!this->isValid(handle))
+		return false;
+
+	this->remove(this->getIndex(handle));
+	return true;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="handle">Handle to check.</param>
+/// <returns>Returns `true` if the referenced entity still exists, else `false`.</returns>
+bool EntityStore::isValid(EntityHandle handle) const
+{
+	return handle.slot < this->slotGenerations_.size() &&
+		this->slotGenerations_[handle.slot] == handle.generation;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="handle">Valid handle of the entity.</param>
+/// <returns>Returns actual index of the entity in the component arrays.</returns>
+std::size_t EntityStore::getIndex(EntityHandle handle) const
+{
+	return this->slotIndices_[handle.slot];
+}
+
+/// <summary>
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns stable handle of the entity.</returns>
+EntityHandle EntityStore::getHandle(std::size_t index) const
+{
+	EntityHandle handle;
+	handle.slot = this->slots_[index];
+	handle.generation = this->slotGenerations_[handle.slot];
+	return handle;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the entities.</returns>
+std::size_t EntityStore::size() const
+{
+	return this->slots_.size();
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns `true` if there is no entity, else `false`.</returns>
+bool EntityStore::empty() const
+{
+	return this->slots_.empty();
+}
+
+/// <summary>
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns left top corner of the bounding box of the entity.</returns>
+sf::Vector2f EntityStore::getPosition(std::size_t index) const
+{
+	return { this->positionX_[index], this->positionY_[index] };
+}
+
+/// <summary>
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns half of the bounding box size of the entity.</returns>
+sf::Vector2f EntityStore::getHalfExtent(std::size_t index) const
+{
+	return { this->halfExtentX_[index], this->halfExtentY_[index] };
+}
+
+/// <summary>
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns speed of the entity.</returns>
+sf::Vector2f EntityStore::getVelocity(std::size_t index) const
+{
+	return { this->velocityX_[index], this->velocityY_[index] };
+}
+
+/// <summary>
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns bounding box of the entity (absolute coordinates).</returns>
+sf::FloatRect EntityStore::getBounds(std::size_t index) const
+{
+	return sf::FloatRect(this->positionX_[index], this->positionY_[index],
+		2 * this->halfExtentX_[index], 2 * this->halfExtentY_[index]);
+}
+
+/// <summary>
+/// Checks whether bounding box of the entity intersects `bounds` (touching boxes do not intersect).
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <param name="bounds">Bounding box to check (absolute coordinates, positive size).</param>
+/// <returns>Returns `true` if the boxes intersect, else `false`.</returns>
+bool EntityStore::isOverlapping(std::size_t index, const sf::FloatRect& bounds) const
+{
+	const float left = this->positionX_[index];
+	const float top = this->positionY_[index];
+	return left < bounds.left + bounds.width && bounds.left < left + 2 * this->halfExtentX_[index] &&
+		top < bounds.top + bounds.height && bounds.top < top + 2 * this->halfExtentY_[index];
+}
+
+/// <summary>
+/// Moves the entity by the given offset.
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <param name="distance">Offset of the movement.</param>
+void EntityStore::move(std::size_t index, sf::Vector2f distance)
+{
+	this->positionX_[index] += distance.x;
+	this->positionY_[index] += distance.y;
+}
+
+/// <summary>
+/// Remembers actual positions of all the entities (start of the simulation tick).
+/// </summary>
+void EntityStore::savePreviousPositions()
+{
+	this->previousX_ = this->positionX_;
+	this->previousY_ = this->positionY_;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="index">Index of the entity.</param>
+/// <param name="alpha">Position between the previous (`0`) and the actual (`1`) tick.</param>
+/// <returns>Returns offset of the interpolated position from the actual one.</returns>
+sf::Vector2f EntityStore::getInterpolationOffset(std::size_t index, float alpha) const
+{
+	return { (this->previousX_[index] - this->positionX_[index]) * (1.0f - alpha),
+			(this->previousY_[index] - this->positionY_[index]) * (1.0f - alpha) };
+}
@@ -0,0 +1,97 @@
+#ifndef ENTITYSTORE_H_
+#define ENTITYSTORE_H_
+
+#include <vector>
+#include <cstdint>
+
+#include "SFML_includes.h"
+
+// Stable reference to the entity of the `EntityStore` (index of the entity changes when other entity is removed).
+struct EntityHandle
+{
+	std::uint32_t slot = 0xFFFFFFFF;
+	std::uint32_t generation = 0;
+};
+
+// Flags of the entity (can be combined).
+enum EntityFlag : std::uint8_t
+{
+	ENTITY_FLAG_NONE = 0,
+	ENTITY_FLAG_STRONG = 1 << 0,
+	// Killed during the tick (ignored by the collisions, removed at the end of the tick).
+	ENTITY_FLAG_DEAD = 1 << 1
+};
+
+// Orientation of the entity (direction of the movement).
+enum EntityOrientation : std::uint8_t
+{
+	ORIENTATION_LEFT = 0,
+	ORIENTATION_RIGHT = 1
+};
+
+// Moving objects of one kind (enemies, bullets) stored as structure of arrays.
+// Components of the entity are on the same index in all the arrays (no holes -> linear iteration),
+// removed entity is replaced by the last one (indices change, handles stay valid).
+class EntityStore
+{
+public:
+	// Components:
+	// Left top corner of the bounding box (absolute coordinates).
+	std::vector<float> positionX_;
+	std::vector<float> positionY_;
+	// Half of the bounding box size.
+	std::vector<float> halfExtentX_;
+	std::vector<float> halfExtentY_;
+	// Speed (pixels per second).
+	std::vector<float> velocityX_;
+	std::vector<float> velocityY_;
+	// `EntityOrientation` value.
+	std::vector<std::uint8_t> orientation_;
+	// `EntityFlag` bit mask.
+	std::vector<std::uint8_t> flags_;
+	// Position at the start of the last simulation tick (for the render interpolation).
+	std::vector<float> previousX_;
+	std::vector<float> previousY_;
+
+	// Initial and setup functions:
+	EntityStore();
+
+	void reserve(std::size_t capacity);
+	void clear();
+	EntityHandle add(sf::Vector2f position, sf::Vector2f halfExtent, sf::Vector2f velocity,
+					std::uint8_t orientation, std::uint8_t flags);
+	void remove(std::size_t index);
+	bool remove(EntityHandle handle);
+
+	// Handle functions:
+	bool isValid(EntityHandle handle) const;
+	std::size_t getIndex(EntityHandle handle) const;
+	EntityHandle getHandle(std::size_t index) const;
+
+	// Functions to obtain info about the entities:
+	std::size_t size() const;
+	bool empty() const;
+	sf::Vector2f getPosition(std::size_t index) const;
+	sf::Vector2f getHalfExtent(std::size_t index) const;
+	sf::Vector2f getVelocity(std::size_t index) const;
+	sf::FloatRect getBounds(std::size_t index) const;
+	bool isOverlapping(std::size_t index, const sf::FloatRect& bounds) const;
+
+	// Movement functions:
+	void move(std::size_t index, sf::Vector2f distance);
+
+	// Render interpolation functions:
+	void savePreviousPositions();
+	sf::Vector2f getInterpolationOffset(std::size_t index, float alpha) const;
+
+private:
+	// Slot of each entity (in the order of the components).
+	std::vector<std::uint32_t> slots_;
+	// Index of the entity in each slot and generation of each slot (increased on removal).
+	std::vector<std::uint32_t> slotIndices_;
+	std::vector<std::uint32_t> slotGenerations_;
+	// Slots of the removed entities (reused by the new ones).
+	std::vector<std::uint32_t> freeSlots_;
+};
+
+#endif
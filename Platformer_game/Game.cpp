@@ -1,4 +1,5 @@
 #include "Game.h"
+#include "SfmlRenderBackend.h"
 
 // Public functions:
 
@@ -7,17 +8,27 @@
 /// </summary>
 /// <param name="filename">Name of the file, where the level setup is stored.</param>
 /// <param name="lifes">Initial number of player lifes.</param>
-Game::Game(const std::string& levelFile, const std::string& fontFile, int lifes)
-	: gravityAcceleration_(320.0f), moveSpeed_(150.0f), enemySpeed_(150.0f),
-	  enemyLoopSec_(3.1f), strikeLoopSec_(1.1f), maxBulletSpeed_(500.0f), 
-	  bulletSize_({ 40, 10 }), jumpSpeed_(550.0f), initLifes_(std::move(lifes)),
-	  levelFile_(levelFile), fontFile_(fontFile)
+/// <param name="streamLevel">Should be the level streamed (objects far from the player frozen, for very large levels).</param>
+/// <param name="backend">Window and drawing backend (`nullptr` -> SFML window).</param>
+/// <param name="tickRate">Number of simulation ticks per second.</param>
+Game::Game(const std::string& levelFile, const std::string& fontFile, int lifes, bool streamLevel,
+	std::unique_ptr<RenderBackend> backend, float tickRate)
+	: Game(levelFile, fontFile, lifes, streamLevel, std::move(backend), tickRate, nullptr)
 {
-	this->gameState_ = GameState::STATE_START;
-	this->initVariables(this->levelFile_, this->initLifes_);
-	this->initWindow(this->fontFile_);
-	this->initMainMenu();
+}
 
+/// <summary>
+/// Creates game object of the already parsed level (shared e.g. by many simulated games, 
+/// no file is read). Streaming is not requested (only large levels are streamed).
+/// </summary>
+/// <param name="level">Parsed level.</param>
+/// <param name="lifes">Initial number of player lifes.</param>
+/// <param name="backend">Window and drawing backend (`nullptr` -> SFML window).</param>
+/// <param name="tickRate">Number of simulation ticks per second.</param>
+Game::Game(std::shared_ptr<const LevelData> level, int lifes,
+	std::unique_ptr<RenderBackend> backend, float tickRate)
+	: Game(std::string(), std::string(), lifes, false, std::move(backend), tickRate, std::move(level))
+{
 }
 
 
@@ -30,7 +41,184 @@ const bool Game::running() const
 {
 	if (this->gameState_ == GameState::STATE_END)
 		return false;
-	return this->window_.isOpen();
+	return this->backend_->isOpen();
+}
+
+/// <summary>
+/// Checks whether the game is played (not in the main menu).
+/// </summary>
+/// <returns>Returns `true` if the game is played, else `false`.</returns>
+bool Game::playing() const
+{
+	return this->gameState_ == GameState::STATE_GAME;
+}
+
+/// <summary>
+/// Starts new game (same as the play button, used when there is no mouse).
+/// </summary>
+/// <param name="updateClock">Clock for measuring time interval between last update and actual time.</param>
+void Game::startGame(sf::Clock& updateClock)
+{
+	this->gameState_ = GameState::STATE_GAME;
+	this->accumulatorSec_ = 0.0f;
+	updateClock.restart();
+
+	// Record the input of the new game.
+	this->recording_.clear();
+	this->recording_.levelFile_ = this->levelFile_;
+	this->recording_.seed_ = this->seed_;
+	this->recording_.gameIndex_ = this->playedGames_;
+	this->recording_.tickRate_ = 1.0f / this->tickSec_;
+	this->recording_.streamLevel_ = this->streamLevel_;
+}
+
+/// <summary>
+/// Throws the actual game away and shows the main menu 
+/// (the level is reset, neither the level nor the font is loaded again).
+/// </summary>
+void Game::resetGame()
+{
+	this->gameState_ = GameState::STATE_START;
+	this->resetVariables(this->initLifes_);
+	this->initView();
+}
+
+/// <summary>
+/// Sets speed of the game time (e.g. `2` -> game runs twice as fast as the real time).
+/// </summary>
+/// <param name="timeScale">Speed of the game time compared to the real time.</param>
+void Game::setTimeScale(float timeScale)
+{
+	this->timeScale_ = timeScale;
+}
+
+/// <summary>
+/// Starts new game with the recorded input (same seed -> same game as the recorded one).
+/// The tick rate of the game should be the same as the recorded one.
+/// </summary>
+/// <param name="replay">Recorded game.</param>
+/// <param name="updateClock">Clock for measuring time interval between last update and actual time.</param>
+void Game::startReplay(const Replay& replay, sf::Clock& updateClock)
+{
+	this->seed_ = replay.seed_;
+	this->playedGames_ = replay.gameIndex_;
+	this->resetVariables(this->initLifes_);
+	this->startGame(updateClock);
+
+	this->replay_ = replay;
+	this->replay_.rewind();
+	this->replaying_ = true;
+}
+
+/// <summary>
+/// Checks whether all the recorded input of the replayed game was used.
+/// </summary>
+/// <returns>Returns `true` if the replay ended (or no replay is played), else `false`.</returns>
+bool Game::isReplayFinished() const
+{
+	return !this->replaying_ || this->replay_.isFinished();
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns recorded input of the actual (or the last finished) game.</returns>
+const Replay& Game::getRecording() const
+{
+	return this->recording_;
+}
+
+/// <summary>
+/// Sets number of the threads updating the enemies and the bullets
+/// (the result of the simulation does not depend on it).
+/// </summary>
+/// <param name="threadCount">Number of the threads (`0` -> number of hardware threads, `1` -> no worker threads).</param>
+void Game::setThreadCount(std::size_t threadCount)
+{
+	if (threadCount == 1)
+		this->threadPool_.reset();
+	else
+		this->threadPool_.reset(new ThreadPool(threadCount));
+}
+
+/// <summary>
+/// Sets seed of all the random streams and restarts them
+/// (same seed and same input -> same session).
+/// </summary>
+/// <param name="seed">Seed of the session.</param>
+void Game::setSeed(std::uint64_t seed)
+{
+	this->seed_ = seed;
+	this->playedGames_ = 0;
+	this->initRandomStreams();
+}
+
+/// <summary>
+/// Simulates one tick of the played game regardless of the real time
+/// (headless runs simulate as fast as possible). Does nothing out of the game.
+/// </summary>
+void Game::simulateTick()
+{
+	if (this->gameState_ != GameState::STATE_GAME)
+		return;
+
+	this->updateTick(this->tickSec_);
+	this->interpolation_ = 1.0f;
+	this->updateView();
+}
+
+/// <summary>
+/// Simulates one tick of the played game with the given player input 
+/// (e.g. actions of the agent, the keyboard and the replay are not used).
+/// </summary>
+/// <param name="input">Pressed keys (`InputKey` bit mask).</param>
+void Game::simulateTick(std::uint8_t input)
+{
+	if (this->gameState_ != GameState::STATE_GAME)
+		return;
+
+	this->updateTick(input, this->tickSec_);
+	this->interpolation_ = 1.0f;
+	this->updateView();
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns points of the actual game.</returns>
+int Game::getPoints() const
+{
+	return this->points_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns remaining lifes of the actual game.</returns>
+int Game::getLifes() const
+{
+	return this->lifes_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns result of the last finished game.</returns>
+const GameResult& Game::getLastResult() const
+{
+	return this->lastResult_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns the player object (e.g. for observations of the game state).</returns>
+Player& Game::getPlayer()
+{
+	return this->player_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns the level (e.g. for observations of the game state).</returns>
+Level& Game::getLevel()
+{
+	return this->level_;
 }
 
 
@@ -54,38 +242,65 @@ void Game::update(sf::Clock& updateClock)
 
 
 /// <summary>
-/// Renders the window (based on the `gameState_`).
-/// 	- clear old frame
-///		- render objects
-///		- display playground or main menu
+/// Prepares the frame (based on the `gameState_`) and passes it to the render thread.
+/// 	- copy visible objects and texts to the snapshot
+///		- publish the snapshot (drawn and displayed by the render thread)
 /// </summary>
 void Game::render()
 {
+	// Nothing is drawn (headless run) -> do not prepare the frame at all.
+	if (!this->backend_->isDrawing())
+		return;
+
+	RenderSnapshot& snapshot = this->backend_->beginFrame();
+
 	if (this->gameState_ == GameState::STATE_GAME)
-		this->renderGame();
+		this->renderGame(snapshot);
 	else
-		this->renderMenu();
+		this->renderMenu(snapshot);
+
+	this->backend_->publishFrame();
 }
 
 
 // Private functions:
 
 /// <summary>
-/// Initializes game variables.
+/// Creates game object and inicializes all variables 
+/// (the level is loaded from the file if the parsed level is not given).
+/// </summary>
+Game::Game(const std::string& levelFile, const std::string& fontFile, int lifes, bool streamLevel,
+	std::unique_ptr<RenderBackend> backend, float tickRate, std::shared_ptr<const LevelData> level)
+	: backend_(std::move(backend)),
+	  tickSec_(1.0f / tickRate), maxUpdateSec_(0.25f), timeScale_(1.0f), replaying_(false),
+	  enemyLoopSec_(3.1f), strikeLoopSec_(1.1f), seed_(0), playedGames_(0),
+	  levelFile_(levelFile), fontFile_(fontFile), streamLevel_(streamLevel),
+	  gravityAcceleration_(320.0f), moveSpeed_(150.0f), jumpSpeed_(550.0f), enemySpeed_(150.0f),
+	  maxBulletSpeed_(500.0f), initLifes_(std::move(lifes))
+{
+	if (!this->backend_)
+		this->backend_.reset(new SfmlRenderBackend());
+
+	this->gameState_ = GameState::STATE_START;
+	if (level)
+		this->initVariables(std::move(level), this->initLifes_);
+	else
+		this->initVariables(this->levelFile_, this->initLifes_);
+	this->initWindow(this->fontFile_);
+	this->initMainMenu();
+}
+
+/// <summary>
+/// Initializes game variables (loads the level).
 /// </summary>
 /// <param name="filename">Filename of the file with level setup.</param>
 /// <param name="lifes">Initial number of player lifes.</param>
 void Game::initVariables(const std::string& filename, int lifes)
 {
-	// Game logic
-	this->endGame_ = false;
-	this->points_ = 0;
-	this->lifes_ = std::move(lifes);
-	this->playerHit_ = false;
-
 	this->player_ = Player({ 40, 40 });
 
-	this->level_ = Level(filename, this->player_);
+	// Window objects of the level are not built if nothing is drawn.
+	this->level_ = Level(filename, this->player_, this->streamLevel_, this->backend_->isDrawing());
 	if (this->level_.error_)
 	// Error happened -> end whole program
 	{
@@ -93,9 +308,63 @@ void Game::initVariables(const std::string& filename, int lifes)
 		this->gameState_ = GameState::STATE_END;
 	}
 
+	this->resetVariables(lifes);
+}
+
+/// <summary>
+/// Initializes game variables from the already parsed level (no file is read).
+/// </summary>
+/// <param name="level">Parsed level (shared).</param>
+/// <param name="lifes">Initial number of player lifes.</param>
+void Game::initVariables(std::shared_ptr<const LevelData> level, int lifes)
+{
+	this->player_ = Player({ 40, 40 });
+
+	this->level_ = Level(std::move(level), this->player_, this->backend_->isDrawing());
+	if (this->level_.error_)
+	{
+		std::cout << "Level file loading error..." << std::endl;
+		this->gameState_ = GameState::STATE_END;
+	}
+
+	this->resetVariables(lifes);
+}
+
+/// <summary>
+/// Sets game variables for the new game (the loaded level is reset, not loaded again).
+/// </summary>
+/// <param name="lifes">Initial number of player lifes.</param>
+void Game::resetVariables(int lifes)
+{
+	// Game logic
+	this->endGame_ = false;
+	this->points_ = 0;
+	this->lifes_ = std::move(lifes);
+	this->playerHit_ = false;
+
+	this->player_ = Player({ 40, 40 });
+	this->level_.reset(this->player_);
+
 	// Start measure game intervals.
-	this->changingDirectionClock_.restart();
-	this->strikingClock_.restart();
+	this->changingDirectionSec_ = 0.0f;
+	this->strikingSec_ = 0.0f;
+
+	this->accumulatorSec_ = 0.0f;
+	this->interpolation_ = 1.0f;
+
+	this->initRandomStreams();
+}
+
+/// <summary>
+/// Seeds random streams of the actual game (from the session seed and number of played games).
+/// </summary>
+void Game::initRandomStreams()
+{
+	std::uint64_t gameSeed = this->seed_ + this->playedGames_ * 0x9E3779B97F4A7C15ULL;
+
+	this->directionRandom_.seed(gameSeed, RANDOM_ENEMY_DIRECTION);
+	this->strikeRandom_.seed(gameSeed, RANDOM_ENEMY_STRIKE);
+	this->bulletRandom_.seed(gameSeed, RANDOM_BULLET_SPEED);
 }
 
 /// <summary>
@@ -107,32 +376,32 @@ void Game::initWindow(const std::string& fontFilename)
 	this->videoMode_.height = 800;
 	this->videoMode_.width = 900;
 
-	// Set position to the center of the screen.
-	sf::Vector2i centerWindow = sf::Vector2i(
-		(sf::VideoMode::getDesktopMode().width / 2) - 450,
-		(sf::VideoMode::getDesktopMode().height / 2) - 480);
+	// Window setup (from now on the window is drawn only by the backend):
+	this->backend_->open(this->videoMode_, "Platform Game", fontFilename);
 
-	// Window setup:
-	this->window_.create(this->videoMode_, "Platform Game",
-		sf::Style::Titlebar | sf::Style::Close);
-	this->window_.setPosition(centerWindow);
-
-	// View setup:
-	this->view_.reset(sf::FloatRect(0.0f, 0.0f,
-			(float)this->window_.getSize().x, (float)this->window_.getSize().y));
-	this->view_.setViewport(sf::FloatRect(0.0f, 0.0f, 1.0f, 1.0f));
+	this->initView();
 
 	// Font init:
 	this->initText(fontFilename);
 }
 
+/// <summary>
+/// Initializes the view (whole window, starts at the origin of the map).
+/// </summary>
+void Game::initView()
+{
+	this->view_.reset(sf::FloatRect(0.0f, 0.0f,
+			(float)this->backend_->getSize().x, (float)this->backend_->getSize().y));
+	this->view_.setViewport(sf::FloatRect(0.0f, 0.0f, 1.0f, 1.0f));
+}
+
 /// <summary>
 /// Initializes all used texts in the window.
 /// </summary>
 /// <param name="fontFilename">Filename where of file where the font is stored.</param>
 void Game::initText(const std::string& fontFilename)
 {
-	if (!this->textFont_.loadFromFile(fontFilename))
+	if (!this->backend_->loadFont(this->textFont_, fontFilename))
 	// Font cann't be loaded.
 	{
 		std::cout << "Cann't read the font file." << std::endl;
@@ -140,7 +409,6 @@ void Game::initText(const std::string& fontFilename)
 
 	// Init the texts:
 	this->initButtonsText();
-	this->initGameText();
 }
 
 /// <summary>
@@ -196,45 +464,6 @@ void Game::initButtonsText()
 	this->exitButtonText_.setStyle(fontStyle);
 }
 
-/// <summary>
-/// Initializes texts displayed durring the game (score and lifes).
-/// </summary>
-void Game::initGameText()
-{
-	// Text setup:
-	int charSize = 24;
-	const auto& fontColor = sf::Color::White;
-	const auto& fontStyle = sf::Text::Bold;
-
-
-	// Points text:
-	this->pointsText_.setFont(this->textFont_);
-	this->pointsText_.setString("Points: " + std::to_string(this->points_));
-	this->pointsText_.setCharacterSize(charSize);
-	this->pointsText_.setFillColor(fontColor);
-	this->pointsText_.setStyle(fontStyle);
-
-	// Lifes text:
-	this->lifesText_.setFont(this->textFont_);
-	this->lifesText_.setString("Lifes: " + std::to_string(this->lifes_));
-	this->lifesText_.setCharacterSize(charSize);
-	this->lifesText_.setFillColor(fontColor);
-	this->lifesText_.setStyle(fontStyle);
-
-	this->initGameTextPosition();
-}
-
-void Game::initGameTextPosition()
-{
-	// Position variables:
-	float x_center = this->player_.absObject_.getLeftBorder();
-	float x_offset = this->view_.getSize().x / 3;
-	float y_coordinate = this->player_.absObject_.getTopBorder() - this->view_.getSize().y / 3;
-
-	this->pointsText_.setPosition(x_center - x_offset, y_coordinate);
-	this->lifesText_.setPosition(x_center + x_offset, y_coordinate);
-}
-
 /// <summary>
 /// Initalizes main menu (mainly its positioning).
 /// </summary>
@@ -277,13 +506,13 @@ void Game::centerText(sf::Text& text, sf::RectangleShape& object)
 void Game::pollEvents(sf::Clock& updateClock)
 {
 	//Event polling
-	while (this->window_.pollEvent(this->event_))
+	while (this->backend_->pollEvent(this->event_))
 	{
 		switch (this->event_.type)
 		{
 			case sf::Event::Closed:
 				// End Game
-				this->window_.close();
+				this->backend_->close();
 				this->gameState_ = GameState::STATE_END;
 				break;
 
@@ -291,7 +520,7 @@ void Game::pollEvents(sf::Clock& updateClock)
 				if (this->event_.key.code == sf::Keyboard::Escape)
 				// End Game
 				{
-					this->window_.close();
+					this->backend_->close();
 					this->gameState_ = GameState::STATE_END;
 				}
 				break;
@@ -317,10 +546,9 @@ void Game::updateMenu(sf::Clock& updateClock)
 {
 	this->pollEvents(updateClock);
 
-	// Sets the correct view.
+	// Sets the correct view (used by the next frame).
 	this->view_.reset(sf::FloatRect(0.0f, 0.0f, 
-					(float)this->window_.getSize().x, (float)this->window_.getSize().y));
-	this->window_.setView(this->view_);
+					(float)this->backend_->getSize().x, (float)this->backend_->getSize().y));
 
 	// Main title position settings:
 	this->mainTitleText_.setOrigin(this->mainTitleText_.getLocalBounds().width / 2,
@@ -353,6 +581,8 @@ void Game::updateButtonPosition(sf::RectangleShape& object, sf::Text& text, floa
 
 /// <summary>
 /// Updates the game state and checks for the poll events (closing window etc.).
+/// The elapsed real time is simulated by fixed ticks (`tickSec_`), the rest is kept
+/// for the next update -> the game behaves the same for any frame rate.
 /// </summary>
 /// <param name="updateClock">Clock for measuring time interval between last update and actual time.</param>
 void Game::updateGame(sf::Clock& updateClock)
@@ -364,17 +594,81 @@ void Game::updateGame(sf::Clock& updateClock)
 	float elapsedTime = updateClock.getElapsedTime().asSeconds();
 	updateClock.restart();
 
+	// Long hitch -> do not simulate too many ticks at once (the game slows down instead).
+	this->accumulatorSec_ += std::min(elapsedTime, this->maxUpdateSec_) * this->timeScale_;
+
+	while (this->accumulatorSec_ >= this->tickSec_ && this->gameState_ == GameState::STATE_GAME)
+	{
+		this->updateTick(this->tickSec_);
+		this->accumulatorSec_ -= this->tickSec_;
+	}
+
+	// Objects are drawn between the last two ticks.
+	this->interpolation_ = this->accumulatorSec_ / this->tickSec_;
+
+	this->updateView();
+}
+
+/// <summary>
+/// Moves the view after the player and loads level parts around it (if streaming).
+/// </summary>
+void Game::updateView()
+{
+	// View update -> center of the view is the player (used by the next frame).
+	this->view_.setCenter(this->player_.absObject_.getX() + this->backend_->getSize().x / 16,
+		this->player_.absObject_.getY() + this->backend_->getSize().y / 16);
+
+	// Load level parts around the view (if streaming).
+	this->level_.updateStreaming(this->view_.getCenter(), this->view_.getSize());
+}
+
+/// <summary>
+/// Simulates one fixed tick of the game with the input of the player.
+/// </summary>
+/// <param name="elapsedTime">Duration of the tick (in seconds).</param>
+void Game::updateTick(float elapsedTime)
+{
+	// Player input (read from the replay instead of the keyboard).
+	std::uint8_t input = INPUT_NONE;
+	if (this->replaying_)
+		this->replay_.readNext(input);
+	else
+		input = this->readPlayerInput();
+
+	this->updateTick(input, elapsedTime);
+}
+
+/// <summary>
+/// Simulates one fixed tick of the game with the given player input.
+/// </summary>
+/// <param name="input">Pressed keys (`InputKey` bit mask, recorded).</param>
+/// <param name="elapsedTime">Duration of the tick (in seconds).</param>
+void Game::updateTick(std::uint8_t input, float elapsedTime)
+{
+	// Positions at the start of the tick (for the render interpolation).
+	this->player_.absObject_.savePreviousPos();
+	this->level_.savePreviousPositions();
+
+	this->recording_.record(input);
+
 	// Update the player movement.
-	this->controlPlayerMovement(elapsedTime);
+	this->controlPlayerMovement(input, elapsedTime);
 	this->checkPlayerJumping(elapsedTime);
 	this->checkPlayerGravity(elapsedTime);
 
+	// Objects far from the player are frozen for the rest of the tick (if streaming).
+	this->level_.updateActiveArea(this->player_);
+
 	// Update the enemies and bullet movents.
 	this->controlEnemiesMovement(elapsedTime);
+	this->level_.updateCollisionGrid(this->player_);
 	this->controlBulletsMovement(elapsedTime);
 
 	this->checkPlayerDeath();
 
+	// Bullets spawned and destroyed and enemies killed during the tick.
+	this->level_.applyEntityChanges();
+
 	// Player reached the finish.
 	if (this->level_.checkFinishCollistion(this->player_))
 		this->endGame_ = true;
@@ -382,12 +676,6 @@ void Game::updateGame(sf::Clock& updateClock)
 	// End of the game -> do proper actions.
 	if (this->endGame_ == true)
 		this->updateEndGame();
-
-
-	// View update -> center of the view is the player.
-	this->view_.setCenter(this->player_.absObject_.getX() + this->window_.getSize().x / 16,
-		this->player_.absObject_.getY() + this->window_.getSize().y / 16);
-	this->window_.setView(this->view_);
 }
 
 /// <summary>
@@ -401,24 +689,17 @@ void Game::updateEndGame()
 	else
 		std::cout << "You are death!" << std::endl;
 
-	// Init of the new game.
+	this->lastResult_.won = this->lifes_ > 0;
+	this->lastResult_.points = this->points_;
+	this->lastResult_.lifes = this->lifes_;
+	this->playedGames_++;
+	this->replaying_ = false;
+
+	// Init of the new game (the level is reset, neither the level nor the font is loaded again).
 	this->gameState_ = GameState::STATE_END_MENU;
 	this->initMainMenu();
-	this->initVariables(this->levelFile_, this->initLifes_);
-	this->initWindow(this->fontFile_);
-}
-
-/// <summary>
-/// Updates (points, lifes) and moves by the `offset` (to be at same position in view).
-/// </summary>
-/// <param name="offset">How to move game texts.</param>
-void Game::updateText(sf::Vector2f&& offset)
-{
-	this->pointsText_.setString("Points: " + std::to_string(this->points_));
-	this->lifesText_.setString("Lifes: " + std::to_string(this->lifes_));
-
-	this->pointsText_.move(offset);
-	this->lifesText_.move(offset);
+	this->resetVariables(this->initLifes_);
+	this->initView();
 }
 
 /// <summary>
@@ -427,13 +708,11 @@ void Game::updateText(sf::Vector2f&& offset)
 /// <param name="updateClock">Clock for measuring time interval between last update and actual time.</param>
 void Game::checkButtonClick(sf::Clock& updateClock)
 {
-	sf::Vector2f pos = this->window_.mapPixelToCoords(sf::Mouse::getPosition(this->window_));
+	// The view of the window is set by the render thread -> use the game view.
+	sf::Vector2f pos = this->backend_->getMousePosition(this->view_);
 	if (this->playButton_.getGlobalBounds().contains(pos))
 		// Play button pressed -> start new game
-	{
-		this->gameState_ = GameState::STATE_GAME;
-		updateClock.restart();
-	}
+		this->startGame(updateClock);
 
 	else if (this->exitButton_.getGlobalBounds().contains(pos))
 		// Exit button pressed -> end the program
@@ -441,139 +720,139 @@ void Game::checkButtonClick(sf::Clock& updateClock)
 }
 
 /// <summary>
-/// Renders the Main Menu (start or end of the game loop (death/win)).
+/// Prepares the Main Menu frame (start or end of the game loop (death/win)).
 /// </summary>
-void Game::renderMenu()
+/// <param name="snapshot">Frame to fill.</param>
+void Game::renderMenu(RenderSnapshot& snapshot)
 {
-	this->window_.clear();
-	this->window_.draw(this->mainTitleText_);
-	this->window_.draw(this->playButton_);
-	this->window_.draw(this->playButtonText_);
-	this->window_.draw(this->exitButton_);
-	this->window_.draw(this->exitButtonText_);
-	this->window_.display();
+	snapshot.view_ = this->view_;
+
+	snapshot.quads_.add(this->playButton_);
+	snapshot.quads_.add(this->exitButton_);
+
+	snapshot.addText(this->mainTitleText_);
+	snapshot.addText(this->playButtonText_);
+	snapshot.addText(this->exitButtonText_);
 }
 
 
 /// <summary>
-/// Renders the playground (while game is on).
+/// Prepares the playground frame (while game is on).
 /// </summary>
-void Game::renderGame()
+/// <param name="snapshot">Frame to fill.</param>
+void Game::renderGame(RenderSnapshot& snapshot)
 {
-	this->window_.clear();
-	this->level_.drawMap(this->window_);
-	this->player_.absObject_.drawTo(this->window_);
-	this->window_.draw(this->pointsText_);
-	this->window_.draw(this->lifesText_);
-	this->window_.display();
+	// The view follows the interpolated player position.
+	sf::Vector2f playerOffset = this->player_.absObject_.getInterpolationOffset(this->interpolation_);
+	snapshot.view_ = this->view_;
+	snapshot.view_.move(playerOffset);
+
+	const sf::FloatRect viewBounds(snapshot.view_.getCenter() - snapshot.view_.getSize() / 2.0f,
+		snapshot.view_.getSize());
+	this->level_.drawMap(snapshot.quads_, viewBounds, this->interpolation_);
+	snapshot.quads_.add(this->player_.absObject_.winObject_, playerOffset);
+
+	// HUD is drawn in the screen space by the render thread.
+	snapshot.setHud(this->points_, this->lifes_);
 }
 
 
 /// <summary>
-/// Moves with all the enemies in the actual direction and with default speed.
+/// Moves with all the enemies in the actual direction and with default speed
+/// (in parallel, each enemy changes only its own state).
 /// </summary>
-/// <param name="allEnemies">Vector of all living enemies.</param>
+/// <param name="allEnemies">All living enemies.</param>
 /// <param name="elapsedTime">Elapsed time since the last update (for proper update).</param>
-void Game::moveEnemies(std::vector<Enemy>& allEnemies, float elapsedTime)
+void Game::moveEnemies(EntityStore& allEnemies, float elapsedTime)
 {
-	for (auto&& enemy : allEnemies)
+	const float distance = this->enemySpeed_ * elapsedTime;
+	this->runParallel(allEnemies.size(), [this, &allEnemies, distance](std::size_t begin, std::size_t end)
 	{
-		if (!enemy.getOrientation())
-		// move left
+		for (std::size_t enemy = begin; enemy < end; enemy++)
+			this->moveEnemy(allEnemies, enemy, distance);
+	});
+}
+
+/// <summary>
+/// Moves with the enemy in the actual direction, changes the direction in front of an obstacle or a hole.
+/// </summary>
+/// <param name="allEnemies">All living enemies.</param>
+/// <param name="enemy">Index of the enemy.</param>
+/// <param name="distance">Distance to move.</param>
+void Game::moveEnemy(EntityStore& allEnemies, std::size_t enemy, float distance)
+{
+	// Enemies in not loaded part of the map are frozen.
+	if (!this->level_.isObjectActive(allEnemies, enemy))
+		return;
+
+	if (allEnemies.orientation_[enemy] == ORIENTATION_LEFT)
+	// move left
+	{
+		if (!this->level_.moveEntity(allEnemies, enemy, { -distance, 0 }) ||
+			this->level_.checkLeftEdgeFall(allEnemies, enemy))
+		// Obstacle or hole in the actual direction -> change direction
 		{
-			if (!this->level_.moveLivingObjectLeft(enemy, this->enemySpeed_ * elapsedTime) ||
-				this->level_.checkLeftEdgeFall(enemy))
-			// Obstacle or hole in the actual direction -> change direction
-			{
-				enemy.changeOrientation(true);
-			}
+			allEnemies.orientation_[enemy] = ORIENTATION_RIGHT;
 		}
-		else
-		// move right
+	}
+	else
+	// move right
+	{
+		if (!this->level_.moveEntity(allEnemies, enemy, { distance, 0 }) ||
+			this->level_.checkRightEdgeFall(allEnemies, enemy))
+		// Obstacle or hole in the actual direction -> change direction
 		{
-			if (!this->level_.moveLivingObjectRight(enemy, this->enemySpeed_ * elapsedTime) ||
-				this->level_.checkRightEdgeFall(enemy))
-			// Obstacle or hole in the actual direction -> change direction
-			{
-				enemy.changeOrientation(false);
-			}
+			allEnemies.orientation_[enemy] = ORIENTATION_LEFT;
 		}
 	}
 }
 
 /// <summary>
-/// Coordinates bullets movement.
+/// Coordinates bullets movement (all the bullets in one pass).
+/// Bullets are moved and their collisions are found in parallel, the side effects (hits, kills, strikes)
+/// are applied afterwards in the order of the bullets (same result for any number of the threads).
+/// Destroyed and spawned bullets are applied at the end of the tick (see `Level::applyEntityChanges`).
 /// </summary>
-/// <param name="allBullets">Vector of bullets to coordinate (weak/strong).</param>
+/// <param name="allBullets">Pool of the bullets (weak and strong).</param>
 /// <param name="elapsedTime">Elapsed time since the last update (for proper update).</param>
-void Game::moveBullets(std::vector<Bullet>& allBullets, float elapsedTime)
+void Game::moveBullets(EntityStore& allBullets, float elapsedTime)
 {
-	// No bullet to check.
-	if (allBullets.size() <= 0)
-		return;
-
-	bool areStrong = allBullets.begin()->isStrong();
-	for (auto bullet = allBullets.begin(); bullet != allBullets.end(); bullet++)
-	// Check collision, if collistion -> return (we need to erase the item from container).
+	this->bulletSteps_.resize(allBullets.size());
+	this->collisionQueries_.resize((allBullets.size() + entityGrainSize_ - 1) / entityGrainSize_);
+	this->runParallel(allBullets.size(), [this, &allBullets, elapsedTime](std::size_t begin, std::size_t end)
 	{
-		const auto& speed = bullet->getSpeed();
+		GridQuery& query = this->collisionQueries_[begin / entityGrainSize_];
+		for (std::size_t bullet = begin; bullet < end; bullet++)
+			this->bulletSteps_[bullet] = this->stepBullet(allBullets, bullet, elapsedTime, query);
+	});
 
-		if (!this->moveBullet(bullet, speed * elapsedTime))
-		// Bullet crashed with the obstacle -> destroy it
+	for (std::size_t bullet = 0; bullet < allBullets.size(); bullet++)
+	{
+		const BulletStep& step = this->bulletSteps_[bullet];
+		switch (step.event)
 		{
-			allBullets.erase(bullet);
-			return;
-		}
+		case BULLET_EVENT_OBSTACLE:
+		case BULLET_EVENT_LEFT_MAP:
+			// Bullet crashed with the obstacle or is outside of the map -> destroy it
+			this->level_.despawnBullet(bullet);
+			break;
 
-		if (this->level_.checkObjectLeftMap(*bullet))
-		// bullet is outside of the map -> destroy it
-		{
-			allBullets.erase(bullet);
-			return;
-		}
-		else if (this->player_.isCollidingWithObject(bullet->absObject_))
-		// Player hit -> propagate the info
-		{
+		case BULLET_EVENT_PLAYER_HIT:
+			// Player hit -> propagate the info
 			this->playerHit_ = true;
-			allBullets.erase(bullet);
-			return;
-		}
-		else if (this->level_.checkEnemyBulletCollision(*bullet))
-		// Enemy hit -> kill him (if strong) / revange (if weak)
-		{
-			if (!bullet->isStrong())
+			this->level_.despawnBullet(bullet);
+			break;
+
+		case BULLET_EVENT_ENEMY_HIT:
+			// Enemy hit -> kill him (if strong) / revange (if weak)
+			if (!this->level_.applyEnemyBulletCollision(allBullets, bullet, step.enemy))
+				// Enemy already killed by other bullet (no other enemy hit).
+				break;
+
+			if (!(allBullets.flags_[bullet] & ENTITY_FLAG_STRONG))
 			// Weak bullet -> strike strong bullet in opposite direction
 			{
-				bullet->becomeStronger();
-				const auto& speed = bullet->getSpeed();
-
-				// Operations to avoid killing itself (sometimes can happen).
-				if (this->moveBullet(bullet, speed * elapsedTime))
-				// bullet can live first move.
-				{
-					if (speed.x < 0)
-					// moving left
-					{
-						if (this->level_.moveLivingObjectLeft(*bullet, this->bulletSize_.x))
-						// Move one time the bullet size -> if possible strike strong
-						{
-							auto bul = *bullet;
-							this->level_.addBullet(std::move(bul));
-							std::cout << "Striking strong bullet as revange!!!" << std::endl;
-						}
-					}
-					else
-					// moving right
-					{
-						if (this->level_.moveLivingObjectRight(*bullet, this->bulletSize_.x))
-						// Move one time the bullet size -> if possible strike strong
-						{
-							auto bul = *bullet;
-							this->level_.addBullet(std::move(bul));
-							std::cout << "Striking strong bullet as revange!!!" << std::endl;
-						}
-					}
-				}
+				this->strikeRevengeBullet(allBullets, bullet, elapsedTime);
 			}
 			else
 			// Strong bullet -> enemy is killed
@@ -581,90 +860,124 @@ void Game::moveBullets(std::vector<Bullet>& allBullets, float elapsedTime)
 				std::cout << "Enemy was hit by his mates!!!" << std::endl;
 			}
 
-			allBullets.erase(bullet);
+			this->level_.despawnBullet(bullet);
+			break;
 
-			return;
+		default:
+			break;
 		}
 	}
 }
 
-
 /// <summary>
-/// Moves with the bullet in the given direction (`speed`).
+/// Moves the bullet and finds its first collision (can run in parallel with the other bullets,
+/// only the position of the bullet is changed).
 /// </summary>
-/// <param name="bullet">Iterator to bullet object to move with.</param>
-/// <param name="speed">Bullet offset (how to move it).</param>
-/// <returns>Returns `true` if movement is possible (not obstacle in the way), else `false`.</returns>
-bool Game::moveBullet(std::vector<Bullet>::iterator bullet, const sf::Vector2f& speed)
+/// <param name="allBullets">Pool of the bullets.</param>
+/// <param name="bullet">Index of the bullet.</param>
+/// <param name="elapsedTime">Elapsed time since the last update (for proper update).</param>
+/// <param name="query">Buffers of the grid query of the calling thread.</param>
+/// <returns>Returns the found collision of the bullet.</returns>
+BulletStep Game::stepBullet(EntityStore& allBullets, std::size_t bullet, float elapsedTime, GridQuery& query)
 {
-	if (speed.x < 0)
-	// Move left
-	{
-		if (!this->level_.moveLivingObjectLeft(*bullet, -speed.x))
-			return false;
-	}
-	else
-	// Move right
+	BulletStep step;
+
+	// Bullets in not loaded part of the map are frozen.
+	if (!this->level_.isObjectActive(allBullets, bullet))
+		return step;
+
+	std::size_t enemy;
+	if (!this->level_.moveEntity(allBullets, bullet, allBullets.getVelocity(bullet) * elapsedTime))
+		step.event = BULLET_EVENT_OBSTACLE;
+	else if (this->level_.checkObjectLeftMap(allBullets, bullet))
+		step.event = BULLET_EVENT_LEFT_MAP;
+	else if (this->level_.checkPlayerBulletCollision(allBullets, bullet))
+		step.event = BULLET_EVENT_PLAYER_HIT;
+	else if (this->level_.findEnemyBulletCollision(allBullets, bullet, enemy, query))
 	{
-		if (!this->level_.moveLivingObjectRight(*bullet, speed.x))
-			return false;
+		step.event = BULLET_EVENT_ENEMY_HIT;
+		step.enemy = static_cast<std::uint32_t>(enemy);
 	}
 
-	if (speed.y < 0)
-	// Move up
-	{
-		if (!this->level_.jumpLivingObject(*bullet, -speed.y))
-			return false;
-	}
-	else
-	// Move down
+	return step;
+}
+
+/// <summary>
+/// Strikes the strong bullet back from the position of the weak bullet which hit the enemy.
+/// </summary>
+/// <param name="allBullets">Pool of the bullets.</param>
+/// <param name="bullet">Index of the weak bullet (destroyed after the strike).</param>
+/// <param name="elapsedTime">Elapsed time since the last update (for proper update).</param>
+void Game::strikeRevengeBullet(EntityStore& allBullets, std::size_t bullet, float elapsedTime)
+{
+	// Opposite direction.
+	const sf::Vector2f speed = -allBullets.getVelocity(bullet);
+	allBullets.velocityX_[bullet] = speed.x;
+	allBullets.velocityY_[bullet] = speed.y;
+
+	// Operations to avoid killing itself (sometimes can happen).
+	// Move one time the bullet size -> if possible strike strong
+	const float distance = speed.x < 0 ? -this->level_.getBulletSize().x : this->level_.getBulletSize().x;
+	if (this->level_.moveEntity(allBullets, bullet, speed * elapsedTime) &&
+		this->level_.moveEntity(allBullets, bullet, { distance, 0 }) &&
+		this->level_.spawnBullet(allBullets.getPosition(bullet) + allBullets.getHalfExtent(bullet), speed, true))
 	{
-		if (!this->level_.fallLivingObject(*bullet, speed.y))
-			return false;
+		std::cout << "Striking strong bullet as revange!!!" << std::endl;
 	}
+}
 
-	return true;
+/// <summary>
+/// Samples movement keys of the player.
+/// </summary>
+/// <returns>Returns pressed keys (`InputKey` bit mask).</returns>
+std::uint8_t Game::readPlayerInput()
+{
+	std::uint8_t input = INPUT_NONE;
+	if (this->backend_->isKeyPressed(sf::Keyboard::Left) ||
+		this->backend_->isKeyPressed(sf::Keyboard::A))
+		input |= INPUT_LEFT;
+	if (this->backend_->isKeyPressed(sf::Keyboard::Right) ||
+		this->backend_->isKeyPressed(sf::Keyboard::D))
+		input |= INPUT_RIGHT;
+	if (this->backend_->isKeyPressed(sf::Keyboard::Up) ||
+		this->backend_->isKeyPressed(sf::Keyboard::W))
+		input |= INPUT_UP;
+
+	return input;
 }
 
 /// <summary>
 /// Checks whether movent keys was pressed -> if so does proper actions
 /// </summary>
+/// <param name="input">Pressed keys of the tick (`InputKey` bit mask).</param>
 /// <param name="elapsedTime">Elapsed time since the last update (for proper update).</param>
-void Game::controlPlayerMovement(float elapsedTime)
+void Game::controlPlayerMovement(std::uint8_t input, float elapsedTime)
 {
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) ||
-		sf::Keyboard::isKeyPressed(sf::Keyboard::A))
+	if (input & INPUT_LEFT)
 		// Move Left
 	{
-		if (this->level_.moveLivingObjectLeft(this->player_, this->moveSpeed_ * elapsedTime))
-		{
-			this->checkCoinGain();
-			this->updateText({ -this->moveSpeed_ * elapsedTime, 0 });
-		}
+		// Player moves at least to the obstacle.
+		this->level_.moveLivingObject(this->player_, { -this->moveSpeed_ * elapsedTime, 0 });
+		this->checkCoinGain();
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) ||
-		sf::Keyboard::isKeyPressed(sf::Keyboard::D))
+	if (input & INPUT_RIGHT)
 		// Move Right
 	{
-		if (this->level_.moveLivingObjectRight(this->player_, this->moveSpeed_ * elapsedTime))
-		{
-			this->checkCoinGain();
-			this->updateText({ this->moveSpeed_ * elapsedTime, 0 });
-		}
+		// Player moves at least to the obstacle.
+		this->level_.moveLivingObject(this->player_, { this->moveSpeed_ * elapsedTime, 0 });
+		this->checkCoinGain();
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)
-		|| sf::Keyboard::isKeyPressed(sf::Keyboard::W))
+	if (input & INPUT_UP)
 		// Start Jumping (not falling or jumping and key `Up`/`W` pressed).
 	{
 		if (this->player_.canJump() && !this->player_.isJumping())
 		{
-			if (this->level_.jumpLivingObject(this->player_, this->jumpSpeed_ * elapsedTime))
+			if (this->level_.moveLivingObject(this->player_, { 0, -this->jumpSpeed_ * elapsedTime }))
 				// Jumping is possible (not obstacle in the way).
 			{
 				this->player_.startJumping(this->jumpSpeed_);
-				this->checkCoinGain();
-				this->updateText({ 0, -this->jumpSpeed_ * elapsedTime });
 			}
+			this->checkCoinGain();
 		}
 	}
 }
@@ -685,21 +998,24 @@ void Game::controlEnemiesMovement(float elapsedTime)
 
 	this->moveEnemies(allEnemies, elapsedTime);
 
+	this->changingDirectionSec_ += elapsedTime;
+	this->strikingSec_ += elapsedTime;
+
 	// Random direction change.
-	if (this->changingDirectionClock_.getElapsedTime().asSeconds() >= this->enemyLoopSec_)
+	if (this->changingDirectionSec_ >= this->enemyLoopSec_)
 	{
 		this->changeEnemiesOrientation(allEnemies);
 
-		this->changingDirectionClock_.restart();
+		this->changingDirectionSec_ = 0.0f;
 		std::cout << "Direction timeout" << std::endl;
 	}
 
 	// Random striking bulltets.
-	if (this->strikingClock_.getElapsedTime().asSeconds() >= this->strikeLoopSec_)
+	if (this->strikingSec_ >= this->strikeLoopSec_)
 	{
 		this->strikeBulletEnemies(allEnemies);
 
-		this->strikingClock_.restart();
+		this->strikingSec_ = 0.0f;
 		std::cout << "Strike timeout" << std::endl;
 	}
 }
@@ -709,15 +1025,13 @@ void Game::controlEnemiesMovement(float elapsedTime)
 /// </summary>
 void Game::controlBulletsMovement(float elapsedTime)
 {
-	auto& allStrongBullets = this->level_.getAllStrongBullets();
-	this->moveBullets(allStrongBullets, elapsedTime);
-	auto& allWeakBullets = this->level_.getAllWeakBullets();
-	this->moveBullets(allWeakBullets, elapsedTime);
+	this->moveBullets(this->level_.getAllBullets(), elapsedTime);
 }
 
 /// <summary>
 /// Checks whether player is jumping. If so then actualizes actual player's 
-/// jumping speed if time interval for gravity update lasted (- gravity acceleration).
+/// jumping speed (- gravity acceleration) and moves the player up.
+/// Jumping ends at the apex or under the ceiling (player stops at the contact in the same tick).
 /// </summary>
 /// <param name="elapsedTime">Elapsed time since the last update (for proper update).</param>
 void Game::checkPlayerJumping(float elapsedTime)
@@ -730,13 +1044,11 @@ void Game::checkPlayerJumping(float elapsedTime)
 		if (speed < 0)
 		// Still jumping (negative falling speed).
 		{
-			if (this->level_.jumpLivingObject(this->player_, -speed * elapsedTime))
-			// Still jumping
-			{
-				this->checkCoinGain();
-				this->updateText({ 0, speed * elapsedTime });
+			const bool jumped = this->level_.moveLivingObject(this->player_, { 0, speed * elapsedTime });
+			this->checkCoinGain();
+			if (jumped)
+			// Still jumping (else the head hit the ceiling)
 				return;
-			}
 		}
 
 		// End of jumping -> reset all jumping setup.
@@ -747,7 +1059,9 @@ void Game::checkPlayerJumping(float elapsedTime)
 
 /// <summary>
 /// Checks whether player is falling. If so then actualizes actual player's
-/// jumping speed if time interval for gravity update lasted (- gravity acceleration).
+/// falling speed (+ gravity acceleration) and moves the player down. 
+/// If the floor is nearer than the fall distance, the player lands on it in the same tick
+/// (one sweep of the tile grid, same cost for any falling speed).
 /// </summary>
 /// <param name="elapsedTime">Elapsed time since the last update (for proper update).</param>
 void Game::checkPlayerGravity(float elapsedTime)
@@ -755,23 +1069,20 @@ void Game::checkPlayerGravity(float elapsedTime)
 	this->updatePlayerGravitySpeed(elapsedTime);
 	if (!this->player_.isJumping())
 	{
-		float speed = this->player_.getActualSpeed();
-		while (!this->level_.fallLivingObject(this->player_, speed * elapsedTime))
-		// Repeat until player falls down (if actual falling speed is to high)
-		{
-			speed -= this->gravityAcceleration_ * elapsedTime;
-			if (speed < this->gravityAcceleration_ * elapsedTime)
-			// Player is down.
-			{
-				this->player_.stopFalling();
-				return;
-			}
-		}
+		const float speed = this->player_.getActualSpeed();
+		const bool falling = this->level_.moveLivingObject(this->player_, { 0, speed * elapsedTime });
+		this->checkCoinGain();
 
+		if (falling)
 		// Player is still falling.
-		this->checkCoinGain();
-		this->updateText({ 0, speed * elapsedTime });
-		this->player_.startFalling(speed);
+		{
+			this->player_.startFalling(speed);
+		}
+		else
+		// Player is down (standing on the floor).
+		{
+			this->player_.stopFalling();
+		}
 	}
 }
 
@@ -794,9 +1105,6 @@ void Game::checkPlayerDeath()
 
 		this->level_.movePlayerToStart(this->player_);
 
-		this->initGameTextPosition();
-
-
 		if (this->lifes_ <= 0)
 		// End of the game check.
 		{
@@ -819,6 +1127,24 @@ void Game::checkCoinGain()
 }
 
 
+/// <summary>
+/// Runs the loop body over chunks of `entityGrainSize_` entities covering [0, count),
+/// in parallel if there is the thread pool (chunks do not depend on the number of the threads).
+/// </summary>
+/// <param name="count">Number of the entities.</param>
+/// <param name="body">Loop body called with the range [begin, end) of one chunk.</param>
+void Game::runParallel(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body)
+{
+	if (this->threadPool_)
+	{
+		this->threadPool_->parallelFor(count, entityGrainSize_, body);
+		return;
+	}
+
+	for (std::size_t begin = 0; begin < count; begin += entityGrainSize_)
+		body(begin, std::min(count, begin + entityGrainSize_));
+}
+
 /// <summary>
 /// Updates player falling speed based on the interval since the last update.
 /// </summary>
@@ -833,13 +1159,12 @@ void Game::updatePlayerGravitySpeed(float elapsedTime)
 /// Randomly changes the orientation of the enemies.
 /// </summary>
 /// <param name="allEnemies">Container of enemies for the action.</param>
-void Game::changeEnemiesOrientation(std::vector<Enemy>& allEnemies)
+void Game::changeEnemiesOrientation(EntityStore& allEnemies)
 {
-	for (auto&& enemy : allEnemies)
+	for (auto&& orientation : allEnemies.orientation_)
 	{
 		// Generate new random orientation
-		auto randOrientation = rand() % 2;
-		enemy.changeOrientation(randOrientation == 1);
+		orientation = this->directionRandom_.nextBool() ? ORIENTATION_RIGHT : ORIENTATION_LEFT;
 	}
 }
 
@@ -847,32 +1172,36 @@ void Game::changeEnemiesOrientation(std::vector<Enemy>& allEnemies)
 /// Randomly strikes bullets (from random enemy with random speed and random orientation).
 /// </summary>
 /// <param name="allEnemies">Container of enemies to choose who will strike.</param>
-void Game::strikeBulletEnemies(std::vector<Enemy>& allEnemies)
+void Game::strikeBulletEnemies(EntityStore& allEnemies)
 {
 	// Randomly choose the enemy.
-	auto enemy = allEnemies.begin();
-	int randomOffset = static_cast <int> (rand()) / (static_cast <int> (RAND_MAX / (allEnemies.size())));
-	std::advance(enemy, randomOffset);
+	auto enemy = this->strikeRandom_.nextBelow(static_cast<std::uint32_t>(allEnemies.size()));
 
-	auto bullet = enemy->strike(this->bulletSize_, this->enemySpeed_, this->maxBulletSpeed_);
+	// Frozen enemy (not loaded part of the map) cann't strike.
+	if (!this->level_.isObjectActive(allEnemies, enemy))
+		return;
+
+	// Random horizontal speed generation 
+	// (minimal speed is the enemy speed to prevent killing itself).
+	float randomSpeedX = this->bulletRandom_.nextFloat(this->enemySpeed_, this->maxBulletSpeed_);
+
+	float randomSpeedY = 0;
+	// 50:50 if bullet should have also vertical speed
+	if (this->bulletRandom_.nextBool())
+		randomSpeedY = this->bulletRandom_.nextFloat(-this->maxBulletSpeed_ / 2, this->maxBulletSpeed_ / 2);
 
-	if (!enemy->getOrientation())
+	// bullet always goes the way the enemy is moving (to prevent collisions).
+	float enemyWidth = 2 * allEnemies.halfExtentX_[enemy];
+	if (allEnemies.orientation_[enemy] == ORIENTATION_LEFT)
 	// moving left -> striking left
 	{
-		// Move bullet outside of the enemy.
-		if (this->level_.moveLivingObjectLeft(bullet, enemy->absObject_.winObject_.getSize().x))
-		{
-			this->level_.addBullet(std::move(bullet));
-		}
+		randomSpeedX = -randomSpeedX;
+		enemyWidth = -enemyWidth;
 	}
 
-	else
-	// moving right -> striking right
-	{
-		// Move bullet outside of the enemy.
-		if (this->level_.moveLivingObjectRight(bullet, enemy->absObject_.winObject_.getSize().x))
-		{
-			this->level_.addBullet(std::move(bullet));
-		}
-	}
+	// Bullet is placed outside of the enemy (obstacle there -> no strike).
+	this->level_.spawnBullet(
+		{ allEnemies.positionX_[enemy] + allEnemies.halfExtentX_[enemy] + enemyWidth,
+			allEnemies.positionY_[enemy] + allEnemies.halfExtentY_[enemy] },
+		{ randomSpeedX, randomSpeedY }, false);
 }
@@ -8,12 +8,20 @@
 #include <sstream>
 #include <random>
 #include <math.h>
+#include <memory>
+#include <algorithm>
+#include <functional>
 
 #include "SFML_includes.h"
 
 #include "Player.h"
 #include "Level.h"
-#include "Bullet.h"
+#include "RenderBackend.h"
+#include "RenderSnapshot.h"
+#include "RandomStream.h"
+#include "PlayerInput.h"
+#include "Replay.h"
+#include "ThreadPool.h"
 
 
 enum class GameState
@@ -24,18 +32,69 @@ enum class GameState
 	STATE_END
 };
 
+// Result of the last finished game (the game is reset right after its end).
+struct GameResult
+{
+	bool won = false;
+	int points = 0;
+	int lifes = 0;
+};
+
+// Collision of the bullet found by the parallel part of the bullet update.
+enum BulletEvent : std::uint8_t
+{
+	BULLET_EVENT_NONE = 0,
+	BULLET_EVENT_OBSTACLE = 1,
+	BULLET_EVENT_LEFT_MAP = 2,
+	BULLET_EVENT_PLAYER_HIT = 3,
+	BULLET_EVENT_ENEMY_HIT = 4
+};
+
+// Result of the parallel part of the bullet update (applied in the order of the bullets).
+struct BulletStep
+{
+	std::uint8_t event = BULLET_EVENT_NONE;
+	// Index of the hit enemy (`BULLET_EVENT_ENEMY_HIT`).
+	std::uint32_t enemy = 0;
+};
+
 class Game
 {
 public:
-	Game(const std::string& levelFile, const std::string& fontFile, int lifes);
+	Game(const std::string& levelFile, const std::string& fontFile, int lifes, bool streamLevel = false,
+		std::unique_ptr<RenderBackend> backend = nullptr, float tickRate = 120.0f);
+	Game(std::shared_ptr<const LevelData> level, int lifes,
+		std::unique_ptr<RenderBackend> backend, float tickRate = 120.0f);
 
 	const bool running() const;
+	bool playing() const;
+	void startGame(sf::Clock& updateClock);
+	void resetGame();
+	void setSeed(std::uint64_t seed);
+	void setTimeScale(float timeScale);
+	void setThreadCount(std::size_t threadCount);
+
+	// Replay functions:
+	void startReplay(const Replay& replay, sf::Clock& updateClock);
+	bool isReplayFinished() const;
+	const Replay& getRecording() const;
+
+	// Simulation without real time (headless runs):
+	void simulateTick();
+	void simulateTick(std::uint8_t input);
+	int getPoints() const;
+	int getLifes() const;
+	const GameResult& getLastResult() const;
+	Player& getPlayer();
+	Level& getLevel();
 	void update(sf::Clock& updateClock);
 	void render();
 
 private:
+	// Window, input and drawing (real SFML window or nothing in headless runs).
+	std::unique_ptr<RenderBackend> backend_;
+
 	// SFML variables:
-	sf::RenderWindow window_;
 	sf::VideoMode videoMode_;
 	sf::Event event_;
 	sf::View view_;
@@ -46,31 +105,71 @@ private:
 	sf::Text mainTitleText_;
 	sf::Text playButtonText_;
 	sf::Text exitButtonText_;
-	sf::Text pointsText_;
-	sf::Text lifesText_;
 
 	// Main menu button pictures.
 	sf::RectangleShape playButton_;
 	sf::RectangleShape exitButton_;
 
 
-	// Clocks:
+	// Fixed timestep simulation:
+
+	// Duration of one simulation tick (in seconds).
+	const float tickSec_;
+	// Longest real time simulated by one update (longer hitches are slowed down).
+	const float maxUpdateSec_;
+	// Real time not simulated yet (less than one tick after the update).
+	float accumulatorSec_;
+	// Part of the tick elapsed since the last simulated state (for the render interpolation).
+	float interpolation_;
+	// Speed of the game time compared to the real time.
+	float timeScale_;
+
+
+	// Input of the actual game (recorded each tick).
+	Replay recording_;
+	// Replayed game (the input is read from it instead of the keyboard).
+	Replay replay_;
+	bool replaying_;
+
+
+	// Timers (simulation time):
 
 	// Measures interval for changing the movement direction of the enemies.
-	sf::Clock changingDirectionClock_;
+	float changingDirectionSec_;
 	// Measures interval for next enemy strike.
-	sf::Clock strikingClock_;
+	float strikingSec_;
 
-	// Time interval for each clock (in seconds).
+	// Time interval for each timer (in seconds).
 	const float enemyLoopSec_;
 	const float strikeLoopSec_;
 
 
+	// Parallel update of the entities (`nullptr` -> serial update):
+	std::unique_ptr<ThreadPool> threadPool_;
+	// Number of the entities in one parallel task.
+	static const std::size_t entityGrainSize_ = 128;
+	// Results of the parallel bullet update and grid query buffers of each task.
+	std::vector<BulletStep> bulletSteps_;
+	std::vector<GridQuery> collisionQueries_;
+
+
+	// Random streams (each game of the session has its own sequences derived from the seed):
+	std::uint64_t seed_;
+	std::uint64_t playedGames_;
+
+	RandomStream directionRandom_;
+	RandomStream strikeRandom_;
+	RandomStream bulletRandom_;
+
+
 	GameState gameState_;
 
 	// Filenames necessary for the game.
-	const std::string& levelFile_;
-	const std::string& fontFile_;
+	const std::string levelFile_;
+	const std::string fontFile_;
+
+	// Flag if the level should be streamed around the view.
+	const bool streamLevel_;
 
 	// Game setup:
 	const float gravityAcceleration_;
@@ -80,8 +179,6 @@ private:
 	const float maxBulletSpeed_;
 	const int initLifes_;
 
-	sf::Vector2f bulletSize_;
-
 
 	// Level representation (map)
 	Level level_;
@@ -96,14 +193,21 @@ private:
 	bool playerHit_;
 	bool endGame_;
 
+	GameResult lastResult_;
+
 	// Inicialization functions:
+	Game(const std::string& levelFile, const std::string& fontFile, int lifes, bool streamLevel,
+		std::unique_ptr<RenderBackend> backend, float tickRate, std::shared_ptr<const LevelData> level);
+
 	void initVariables(const std::string& filename, int healths);
+	void initVariables(std::shared_ptr<const LevelData> level, int lifes);
+	void resetVariables(int lifes);
+	void initRandomStreams();
 	void initWindow(const std::string& fontFilename);
+	void initView();
 	void initText(const std::string& fontFilename);
 	void initMainTitleText();
 	void initButtonsText();
-	void initGameText();
-	void initGameTextPosition();
 	void initMainMenu();
 
 	void centerText(sf::Text& text, sf::RectangleShape& rectangle);
@@ -113,21 +217,26 @@ private:
 	void updateMenu(sf::Clock& updateClock);
 	void updateButtonPosition(sf::RectangleShape& object, sf::Text& text, float y_offset);
 	void updateGame(sf::Clock& updateClock);
+	void updateTick(float elapsedTime);
+	void updateTick(std::uint8_t input, float elapsedTime);
+	void updateView();
 	void updateEndGame();
-	void updateText(sf::Vector2f&& offset);
 
 	void checkButtonClick(sf::Clock& updateClock);
 
 	// Render window functions (parts of `render`):
-	void renderMenu();
-	void renderGame();
+	void renderMenu(RenderSnapshot& snapshot);
+	void renderGame(RenderSnapshot& snapshot);
 
 	// Functions which coordinates game objects movement and whole game logic:
-	void moveEnemies(std::vector<Enemy>& allEnemies, float elapsedTime);
-	void moveBullets(std::vector<Bullet>& allBullets, float elapsedTime);
-	bool moveBullet(std::vector<Bullet>::iterator bullet, const sf::Vector2f& speed);
-
-	void controlPlayerMovement(float elapsedTime);
+	void moveEnemies(EntityStore& allEnemies, float elapsedTime);
+	void moveEnemy(EntityStore& allEnemies, std::size_t enemy, float distance);
+	void moveBullets(EntityStore& allBullets, float elapsedTime);
+	BulletStep stepBullet(EntityStore& allBullets, std::size_t bullet, float elapsedTime, GridQuery& query);
+	void strikeRevengeBullet(EntityStore& allBullets, std::size_t bullet, float elapsedTime);
+
+	std::uint8_t readPlayerInput();
+	void controlPlayerMovement(std::uint8_t input, float elapsedTime);
 	void controlEnemiesMovement(float elapsedTime);
 	void controlBulletsMovement(float elapsedTime);
 
@@ -137,9 +246,10 @@ private:
 	void checkCoinGain();
 
 	void updatePlayerGravitySpeed(float elapsedTime);
+	void runParallel(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body);
 
-	void changeEnemiesOrientation(std::vector<Enemy>& allEnemies);
-	void strikeBulletEnemies(std::vector<Enemy>& allEnemies);
+	void changeEnemiesOrientation(EntityStore& allEnemies);
+	void strikeBulletEnemies(EntityStore& allEnemies);
 };
 
 
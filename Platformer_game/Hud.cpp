@@ -0,0 +1,133 @@
+#include "Hud.h"
+
+const char* const Hud::glyphStrip_ = "0123456789-Points:Lifes ";
+
+
+Hud::Hud()
+	: vertices_(sf::Quads)
+{
+}
+
+/// <summary>
+/// Builds the glyph strip of all the HUD characters.
+/// </summary>
+/// <param name="font">Font of the texts (must exist while the HUD is used).</param>
+/// <param name="characterSize">Size of the characters.</param>
+/// <param name="color">Color of the texts.</param>
+/// <param name="bold">Should be the texts bold.</param>
+void Hud::init(const sf::Font& font, unsigned characterSize, sf::Color color, bool bold)
+{
+	this->font_ = &font;
+	this->characterSize_ = characterSize;
+	this->color_ = color;
+	this->bold_ = bold;
+
+	for (const char* character = glyphStrip_; *character != '\0'; character++)
+	{
+		const sf::Glyph& glyph = font.getGlyph(static_cast<sf::Uint32>(*character), characterSize, bold);
+
+		auto& cachedGlyph = this->glyphs_[static_cast<unsigned char>(*character)];
+		cachedGlyph.cached = true;
+		cachedGlyph.bounds = glyph.bounds;
+		cachedGlyph.textureRect = sf::FloatRect(glyph.textureRect);
+		cachedGlyph.advance = glyph.advance;
+	}
+
+	this->dirty_ = true;
+}
+
+/// <summary>
+/// Sets displayed values (marks the HUD to be laid out again only if they changed).
+/// </summary>
+/// <param name="points">Actual score.</param>
+/// <param name="lifes">Actual number of lifes.</param>
+void Hud::setValues(int points, int lifes)
+{
+	if (points == this->points_ && lifes == this->lifes_)
+		return;
+
+	this->points_ = points;
+	this->lifes_ = lifes;
+	this->dirty_ = true;
+}
+
+/// <summary>
+/// Draws the HUD in the screen space (the view of the window is changed).
+/// </summary>
+/// <param name="window">Window where to draw.</param>
+void Hud::drawTo(sf::RenderWindow& window)
+{
+	if (this->font_ == nullptr)
+		return;
+
+	const sf::View& screenView = window.getDefaultView();
+	if (this->dirty_ || screenView.getSize() != this->screenSize_)
+		this->layout(screenView.getSize());
+
+	window.setView(screenView);
+	window.draw(this->vertices_, &this->font_->getTexture(this->characterSize_));
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Lays out both texts. The score is a third of the screen left from the player
+/// and the lifes a third of the screen right from it (the player is drawn
+/// 1/16 of the screen up and left from the screen center).
+/// </summary>
+/// <param name="screenSize">Size of the screen.</param>
+void Hud::layout(sf::Vector2f screenSize)
+{
+	const sf::Vector2f player(screenSize.x / 2 - screenSize.x / 16, screenSize.y / 2 - screenSize.y / 16);
+	const float y = player.y - screenSize.y / 3;
+
+	this->vertices_.clear();
+	this->appendString("Points: " + std::to_string(this->points_), { player.x - screenSize.x / 3, y });
+	this->appendString("Lifes: " + std::to_string(this->lifes_), { player.x + screenSize.x / 3, y });
+
+	this->screenSize_ = screenSize;
+	this->dirty_ = false;
+}
+
+/// <summary>
+/// Adds quads of the string characters (unknown characters are skipped).
+/// </summary>
+/// <param name="string">String to add.</param>
+/// <param name="position">Top left corner of the text (screen coordinates).</param>
+void Hud::appendString(const std::string& string, sf::Vector2f position)
+{
+	// Characters are placed on the baseline (same as `sf::Text`).
+	float x = position.x;
+	const float y = position.y + static_cast<float>(this->characterSize_);
+
+	char previous = '\0';
+	for (char character : string)
+	{
+		const auto code = static_cast<unsigned char>(character);
+		if (code >= 128 || !this->glyphs_[code].cached)
+			continue;
+		const auto& glyph = this->glyphs_[code];
+
+		if (previous != '\0')
+			x += this->font_->getKerning(static_cast<sf::Uint32>(previous), static_cast<sf::Uint32>(character), this->characterSize_);
+		previous = character;
+
+		const float left = x + glyph.bounds.left;
+		const float top = y + glyph.bounds.top;
+		const float right = left + glyph.bounds.width;
+		const float bottom = top + glyph.bounds.height;
+
+		const float textureLeft = glyph.textureRect.left;
+		const float textureTop = glyph.textureRect.top;
+		const float textureRight = textureLeft + glyph.textureRect.width;
+		const float textureBottom = textureTop + glyph.textureRect.height;
+
+		this->vertices_.append(sf::Vertex({ left, top }, this->color_, { textureLeft, textureTop }));
+		this->vertices_.append(sf::Vertex({ right, top }, this->color_, { textureRight, textureTop }));
+		this->vertices_.append(sf::Vertex({ right, bottom }, this->color_, { textureRight, textureBottom }));
+		this->vertices_.append(sf::Vertex({ left, bottom }, this->color_, { textureLeft, textureBottom }));
+
+		x += glyph.advance;
+	}
+}
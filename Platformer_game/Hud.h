@@ -0,0 +1,60 @@
+#ifndef HUD_H_
+#define HUD_H_
+
+#include <string>
+#include <limits>
+
+#include "SFML_includes.h"
+
+// Heads-up display (score and lifes) anchored in the screen space.
+// Characters are drawn from the pre-built glyph strip (one draw call)
+// and the text is laid out again only when the displayed values change.
+class Hud
+{
+public:
+	// Initial and setup functions:
+	Hud();
+	void init(const sf::Font& font, unsigned characterSize, sf::Color color, bool bold);
+
+	// Update function:
+	void setValues(int points, int lifes);
+
+	// Display function:
+	void drawTo(sf::RenderWindow& window);
+
+private:
+	// One pre-built character of the strip.
+	struct CachedGlyph
+	{
+		bool cached = false;
+		sf::FloatRect bounds;
+		sf::FloatRect textureRect;
+		float advance = 0;
+	};
+
+	// All characters the HUD can display.
+	static const char* const glyphStrip_;
+
+	const sf::Font* font_ = nullptr;
+	unsigned characterSize_ = 30;
+	sf::Color color_;
+	bool bold_ = false;
+
+	// Pre-built glyphs (indexed by the character).
+	CachedGlyph glyphs_[128];
+
+	// Displayed values (the text is laid out again only if they change):
+	int points_ = std::numeric_limits<int>::min();
+	int lifes_ = std::numeric_limits<int>::min();
+	bool dirty_ = true;
+
+	// Quads of all the characters (screen coordinates).
+	sf::VertexArray vertices_;
+	// Screen size used for the last layout.
+	sf::Vector2f screenSize_;
+
+	void layout(sf::Vector2f screenSize);
+	void appendString(const std::string& string, sf::Vector2f position);
+};
+
+#endif
@@ -10,63 +10,93 @@ Level::Level() {}
 /// </summary>
 /// <param name="filename">Filename of the file, where level reprezentation is stored.</param>
 /// <param name="player">Object reprezenting the player.</param>
-Level::Level(const std::string& filename, Player& player)
+/// <param name="streaming">Should be the map streamed (objects far from the player frozen,
+/// chunks loaded around the view, large maps are always streamed, see `updateActiveArea`).</param>
+/// <param name="drawable">Should be the window objects of the map built (`false` -> level is never drawn).</param>
+Level::Level(const std::string& filename, Player& player, bool streaming, bool drawable)
 {
-	// Sizes setup:
-	this->obstacleSize_ = {40, 40};
-	this->coinSize_ = { 40, 40 };
-	this->enemySize_ = { 40, 40 };
-
-	// Object variables init:
-	this->error_ = false;
-	this->bottomMapBorder_ = 0;
-	this->rightMapBorder_ = 0;
-	this->startPlayerPosition_ = { 0, 0 };
+	this->initSizes();
 
 	// Loading the map. If failed -> error
-	if (!this->loadMap(filename, player))
+	if (!this->loadMap(filename, player, streaming, drawable))
+		this->error_ = true;
+}
+
+/// <summary>
+/// Initializes `Level` object from already parsed level 
+/// (the parsed level is shared, e.g. by many simulated games).
+/// </summary>
+/// <param name="data">Parsed level.</param>
+/// <param name="player">Object reprezenting the player.</param>
+/// <param name="drawable">Should be the window objects of the map built (`false` -> level is never drawn).</param>
+Level::Level(std::shared_ptr<const LevelData> data, Player& player, bool drawable)
+{
+	this->initSizes();
+
+	if (!data)
 		this->error_ = true;
+	else
+		this->buildLevel(std::move(data), player, false, drawable);
 }
 
 /// <summary>
-/// Reads map in format:
-///			1st line :	width heigth
-///			rest :		length of the line is `width`
-///						number of lines is `height`
-/// 
-///			symbols:	`.` - free space
-///						`#` - obstacle
-///						`P` - player
-///						`E` - enemy
-///						`C` - coin
-///						`F` - finish
+/// Loads the map from the text file (see `LevelData::parseText` for the format)
+/// or from the compiled level file (`.lvlc`).
+/// The text level is compiled to the cache on the first loading, 
+/// later loadings read the compiled level (see `LevelData::loadCached`).
 /// </summary>
 /// <param name="filename">Filename of file with map reprezentaion.</param>
 /// <param name="player">Object reprezentiog the game player.</param>
+/// <param name="streaming">Should be the map streamed.</param>
+/// <param name="drawable">Should be the window objects of the map built.</param>
 /// <returns>Returns `true` if loading was succesfull, else `false`.</returns>
-bool Level::loadMap(const std::string& filename, Player& player)
+bool Level::loadMap(const std::string& filename, Player& player, bool streaming, bool drawable)
 {
-	std::ifstream file(filename);
-
-	// Read width and height and check if data format is ok.
-	if (!(file >> this->width_ >> this->height_ >> std::ws))
-	{
+	LevelData data;
+	if (!data.load(filename))
 		return false;
-	}
-	if (this->width_ <= 0 || this->height_ <= 0)
-	{
-		return false;
-	}
 
-	// Init variables:
-	this->bottomMapBorder_ = this->height_ * this->obstacleSize_.y;
-	this->rightMapBorder_ = this->width_ * this->obstacleSize_.x;
+	this->buildLevel(std::make_shared<const LevelData>(std::move(data)), player, streaming, drawable);
+	return true;
+}
 
-	// Read the map:
-	if (!readMapRepresentation(file, player))
-		return false;
+/// <summary>
+/// Restores the level to its initial state from the parsed level template
+/// (no coin collected, enemies at their spawns, no bullets, player at the start).
+/// The static content and its window objects are kept (no file access, no parsing).
+/// </summary>
+/// <param name="player">Player object to move to the start.</param>
+void Level::reset(Player& player)
+{
+	if (!this->template_)
+	// Level not loaded.
+		return;
 
-	return true;
+	// Coins
+	this->collectedCoins_.clear();
+	if (this->chunks_)
+		this->chunks_->resetCoins();
+
+	// Enemies
+	this->allEnemies_.clear();
+	this->allEnemies_.reserve(this->template_->enemySpawns_.size());
+	for (auto&& spawn : this->template_->enemySpawns_)
+	{
+		this->allEnemies_.add(this->convertRelToAbsoluteCoord(spawn.row, spawn.column), this->enemySize_ / 2.0f,
+			{ 0, 0 }, ORIENTATION_LEFT, ENTITY_FLAG_NONE);
+	}
+
+	// Bullets
+	this->allBullets_.clear();
+	this->spawnedBullets_.clear();
+	this->despawnedBullets_.clear();
+	this->killedEnemies_.clear();
+	this->enemyGrid_.build(this->allEnemies_);
+
+	// Player
+	if (this->template_->hasPlayer_)
+		this->movePlayerToStart(player);
+	this->updateActiveArea(player);
 }
 
 /// <summary>
@@ -81,245 +111,340 @@ void Level::movePlayerToStart(Player& player)
 
 
 /// <summary>
-/// Adds `Bullet` object to proper container (for future manipulation).
+/// Spawns the bullet at the end of the tick (if there is no obstacle on its position).
+/// The bullet is rotated in the direction of its movement, its bounding box covers the rotated bullet.
 /// </summary>
-/// <param name="bullet">Object to be added.</param>
-void Level::addBullet(Bullet&& bullet)
+/// <param name="center">Center of the bullet.</param>
+/// <param name="velocity">Speed of the bullet.</param>
+/// <param name="strong">Should be the bullet strong (kills the enemies).</param>
+/// <returns>Returns `true` if the bullet is spawned, else `false` (obstacle on the position).</returns>
+bool Level::spawnBullet(sf::Vector2f center, sf::Vector2f velocity, bool strong)
 {
-	if (bullet.isStrong())
-		// Strong bullet
-		this->allStrongBullets_.push_back(bullet);
-	else
-		// Weak bullet
-		this->allWeakBullets_.push_back(bullet);
+	// Direction of the bullet (cosine and sine of the rotation).
+	float length = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+	sf::Vector2f direction(1.0f, 0.0f);
+	if (length > 0.0f)
+		direction = velocity / length;
+
+	BulletSpawn bullet;
+	bullet.halfExtent = sf::Vector2f(
+		std::abs(direction.x) * this->bulletSize_.x + std::abs(direction.y) * this->bulletSize_.y,
+		std::abs(direction.y) * this->bulletSize_.x + std::abs(direction.x) * this->bulletSize_.y) / 2.0f;
+	bullet.position = center - bullet.halfExtent;
+	bullet.velocity = velocity;
+	bullet.flags = strong ? ENTITY_FLAG_STRONG : ENTITY_FLAG_NONE;
+
+	if (this->checkObstacleCollision(sf::FloatRect(bullet.position, 2.0f * bullet.halfExtent)))
+		return false;
+
+	this->spawnedBullets_.push_back(bullet);
+	return true;
 }
 
 /// <summary>
-/// Draws all the Level object on the window.
+/// Destroys the bullet at the end of the tick (the bullet stays in the pool until then).
 /// </summary>
-/// <param name="window">Window where to draw the objects</param>
-void Level::drawMap(sf::RenderWindow& window)
+/// <param name="index">Index of the bullet in the pool.</param>
+void Level::despawnBullet(std::size_t index)
 {
-	// Obstacles
-	for (auto&& obstacle : this->allObstacles_) 
+	this->despawnedBullets_.push_back(this->allBullets_.getHandle(index));
+}
+
+/// <summary>
+/// Removes the killed enemies and the destroyed bullets and adds the spawned bullets (end of the tick).
+/// </summary>
+void Level::applyEntityChanges()
+{
+	for (auto&& enemy : this->killedEnemies_)
 	{
-		obstacle.second.absObject_.drawTo(window);
+		this->allEnemies_.remove(enemy);
 	}
+	this->killedEnemies_.clear();
 
-	// Finish positions
-	for (auto&& finishPos : this->finishPositions_)
+	for (auto&& bullet : this->despawnedBullets_)
 	{
-		finishPos.second.absObject_.drawTo(window);
+		this->allBullets_.remove(bullet);
 	}
+	this->despawnedBullets_.clear();
 
-	// Coins
-	for (auto&& coin : this->allCoins_)
+	for (auto&& bullet : this->spawnedBullets_)
 	{
-		coin.second.absObject_.drawTo(window);
+		this->allBullets_.add(bullet.position, bullet.halfExtent, bullet.velocity,
+			bullet.velocity.x < 0 ? ORIENTATION_LEFT : ORIENTATION_RIGHT, bullet.flags);
 	}
+	this->spawnedBullets_.clear();
+}
+
+/// <summary>
+/// Adds the Level objects visible in the view to the batch (in the drawing order).
+/// Static content is chosen by the chunk grid, moving objects by the spatial indices
+/// (rebuilt from the actual positions), objects outside the view are not added.
+/// </summary>
+/// <param name="batch">Batch where to add the objects.</param>
+/// <param name="viewBounds">Displayed area (absolute coordinates).</param>
+/// <param name="alpha">Render interpolation between the previous and the actual tick (1 -> actual positions).</param>
+void Level::drawMap(SpriteBatch& batch, const sf::FloatRect& viewBounds, float alpha)
+{
+	// Obstacles, finish positions and coins
+	if (this->chunks_)
+		this->chunks_->addTo(batch, viewBounds);
 
 	// Enemies
-	for (auto&& enemy : this->allEnemies_)
+	this->findVisibleObjects(this->allEnemies_, this->enemyIndex_, viewBounds);
+	for (auto enemy : this->visibleObjects_)
 	{
-		enemy.absObject_.drawTo(window);
+		this->addEntity(this->allEnemies_, enemy, this->enemySize_, this->enemyColor_, alpha, batch);
 	}
 
-	// Weak bullets
-	for (auto&& weakBullet : this->allWeakBullets_)
+	// Weak bullets and strong bullets (over the weak ones)
+	this->findVisibleObjects(this->allBullets_, this->bulletIndex_, viewBounds);
+	for (auto bullet : this->visibleObjects_)
 	{
-		weakBullet.absObject_.drawTo(window);
+		if (!(this->allBullets_.flags_[bullet] & ENTITY_FLAG_STRONG))
+			this->addEntity(this->allBullets_, bullet, this->bulletSize_, this->weakBulletColor_, alpha, batch);
 	}
-
-	// Strong bullets
-	for (auto&& strongBullet : this->allStrongBullets_)
+	for (auto bullet : this->visibleObjects_)
 	{
-		strongBullet.absObject_.drawTo(window);
+		if (this->allBullets_.flags_[bullet] & ENTITY_FLAG_STRONG)
+			this->addEntity(this->allBullets_, bullet, this->bulletSize_, this->strongBulletColor_, alpha, batch);
 	}
 }
 
 /// <summary>
+/// Remembers positions of the moving objects at the start of the simulation tick
+/// (drawn positions are interpolated from them).
 /// </summary>
-/// <returns>Returns obstacle size.</returns>
-const sf::Vector2f& Level::getObstacleSize()
+void Level::savePreviousPositions()
 {
-	return this->obstacleSize_;
+	this->allEnemies_.savePreviousPositions();
+	this->allBullets_.savePreviousPositions();
 }
 
 /// <summary>
+/// Moves the active area (objects outside of it are frozen) to the chunk of the player.
+/// Called once per tick -> the frozen objects depend only on the simulated ticks
+/// (not on the frame rate, the view or the loaded chunks). Does nothing if the map is not streamed.
 /// </summary>
-/// <returns>Returns const reference to all obstacle objects container.</returns>
-const std::map<int, Obstacle>& Level::getAllObstacles()
+/// <param name="player">Player object (center of the active area).</param>
+void Level::updateActiveArea(LivingObject& player)
 {
-	return this->allObstacles_;
+	if (!this->streaming_)
+		return;
+
+	this->activeChunkRow_ = ChunkStreamer::getChunkIndex(player.bottomBorderRel_);
+	this->activeChunkColumn_ = ChunkStreamer::getChunkIndex(player.rightBorderRel_);
 }
- 
+
 /// <summary>
+/// Moves the center of the loaded window objects (loads chunks around it and evicts far chunks).
+/// Does nothing if the map is not streamed or never drawn.
 /// </summary>
-/// <returns>Returns reference to all Enemy objects.</returns>
-std::vector<Enemy>& Level::getAllEnemies()
+/// <param name="center">Center of the view (absolute coordinates).</param>
+/// <param name="viewSize">Size of the view.</param>
+void Level::updateStreaming(sf::Vector2f center, sf::Vector2f viewSize)
 {
-	return this->allEnemies_;
+	if (!this->streaming_ || !this->chunks_)
+		return;
+
+	if (!this->chunks_->isStreaming())
+	// First update -> start loading on the background thread.
+		this->chunks_->startStreaming(viewSize);
+
+	this->chunks_->update(center, this->collectedCoins_);
 }
 
 /// <summary>
+/// Checks whether the object lies in the active part of the map 
+/// (objects outside of it are frozen while streaming).
 /// </summary>
-/// <returns>Returns reference to all weak bullet objects.</returns>
-std::vector<Bullet>& Level::getAllWeakBullets()
+/// <param name="object">Object to check.</param>
+/// <returns>Returns `true` if the object should be updated, else `false`.</returns>
+bool Level::isObjectActive(LivingObject& object)
 {
-	return this->allWeakBullets_;
+	return this->isCellActive(object.bottomBorderRel_, object.rightBorderRel_);
 }
 
 /// <summary>
+/// Checks whether the entity lies in the active part of the map 
+/// (entities outside of it are frozen while streaming).
 /// </summary>
-/// <returns>Returns reference to all strong bullet objects.</returns>
-std::vector<Bullet>& Level::getAllStrongBullets()
+/// <param name="entities">Container of the entity.</param>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns `true` if the entity should be updated, else `false`.</returns>
+bool Level::isObjectActive(const EntityStore& entities, std::size_t index)
 {
-	return this->allStrongBullets_;
+	return this->isCellActive(
+		this->convertRowFromAbsToRel(entities.positionY_[index] + 2 * entities.halfExtentY_[index]),
+		this->convertColumnFromAbsToRel(entities.positionX_[index] + 2 * entities.halfExtentX_[index]));
 }
 
-
 /// <summary>
-/// Tries to move `livObject` to left by the offset `speed`.
+/// Checks whether the coin in the cell was already collected.
 /// </summary>
-/// <param name="livObject">Object to move.</param>
-/// <param name="speed">Offset to move the object.</param>
-/// <returns>Returns `true` if movement is possible, else `false`.</returns>
-bool Level::moveLivingObjectLeft(LivingObject& livObject, float speed)
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <returns>Returns `true` if the coin was collected (or the cell is outside of the map), else `false`.</returns>
+bool Level::isCoinCollected(int row, int column)
 {
-	// Coordinates of the border to check (of obstacles). 
-	auto prevLeftBorderAbs = this->convertColumnFromRelToAbsolute(livObject.leftBorderRel_);
-
-	if (livObject.absObject_.getLeftBorder() - speed <= prevLeftBorderAbs)
-	// It is neccesary to leave actual relative coordinates
-	{
-		livObject.moveLeft(speed, true);
-		if (this->checkObstacleCollision(livObject))
-		// Movement not possible (obstacle there) -> move to init position
-		{
-			livObject.moveRight(speed, true);
-			return false;
-		}
+	if (!this->tileGrid_ || !this->tileGrid_->isInside(row, column))
 		return true;
-	}
 
-	// Staying at same relative coordinates
-	livObject.moveLeft(speed, false);
-	if (this->checkObstacleCollision(livObject))
-	// Movement not possible (obstacle there) -> move to init position
-	{
-		livObject.moveRight(speed, false);
-		return false;
-	}
-	return true;
+	const auto cell = static_cast<std::uint64_t>(this->convertCoordinatesToInt(row, column));
+	return std::binary_search(this->collectedCoins_.begin(), this->collectedCoins_.end(), cell);
 }
 
 /// <summary>
-/// Tries to move `livObject` to right by the offset `speed`.
 /// </summary>
-/// <param name="livObject">Object to move.</param>
-/// <param name="speed">Offset to move the object.</param>
-/// <returns>Returns `true` if movement is possible, else `false`.</returns>
-bool Level::moveLivingObjectRight(LivingObject& livObject, float speed)
-{
-	// Coordinates of the border to check (of obstacles). 
-	auto prevRightBorderAbs = this->convertColumnFromRelToAbsolute(livObject.rightBorderRel_) + this->obstacleSize_.x;
-	
-	if (livObject.absObject_.getRightBorder() + speed > prevRightBorderAbs)
-	// It is neccesary to leave actual relative coordinates
-	{
-		livObject.moveRight(speed, true);
-		if (this->checkObstacleCollision(livObject))
-		// Movement not possible (obstacle there) -> move to init position
-		{
-			livObject.moveLeft(speed, true);
-			return false;
-		}
-		return true;
-	}
+/// <returns>Returns obstacle size.</returns>
+const sf::Vector2f& Level::getObstacleSize()
+{
+	return this->obstacleSize_;
+}
 
-	// Staying at same relative coordinates.
-	livObject.moveRight(speed, false);
-	if (this->checkObstacleCollision(livObject))
-	// Movement not possible (obstacle there) -> move to init position
-	{
-		livObject.moveLeft(speed, false);
-		return false;
-	}
-	return true;
+/// <summary>
+/// </summary>
+/// <returns>Returns bullet size (not rotated).</returns>
+const sf::Vector2f& Level::getBulletSize()
+{
+	return this->bulletSize_;
 }
 
 /// <summary>
-/// Tries to move `livObject` up by the offset `speed`.
+/// </summary>
+/// <returns>Returns reference to all enemies.</returns>
+EntityStore& Level::getAllEnemies()
+{
+	return this->allEnemies_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns reference to the pool of all bullets (weak and strong).</returns>
+EntityStore& Level::getAllBullets()
+{
+	return this->allBullets_;
+}
+
+
+/// <summary>
+/// Moves `livObject` by the offset `distance` along one axis, 
+/// it stops at the contact with the obstacle in the way (see `sweepBox`).
 /// </summary>
 /// <param name="livObject">Object to move.</param>
-/// <param name="speed">Offset to move the object.</param>
-/// <returns>Returns `true` if movement is possible, else `false`.</returns>
-bool Level::jumpLivingObject(LivingObject& livObject, float speed)
+/// <param name="distance">Offset to move the object (only one nonzero component).</param>
+/// <returns>Returns `true` if whole movement is possible, else `false` (object stopped at the obstacle).</returns>
+bool Level::moveLivingObject(LivingObject& livObject, sf::Vector2f distance)
 {
-	// Coordinates of the border to check (of obstacle). 
-	auto prevTopBorderAbs = this->convertRowFromRelToAbsolute(livObject.topBorderRel_);
+	const SweepHit hit = this->sweepBox(livObject.absObject_.winObject_.getGlobalBounds(), distance);
+	livObject.absObject_.move(hit.offset);
+	this->updateRelativePos(livObject);
 
-	if (livObject.absObject_.getTopBorder() - speed <= prevTopBorderAbs)
-	// It is neccesary to leave actual relative coordinates
+	return !hit.hit;
+}
+
+/// <summary>
+/// Moves the entity by the offset `distance` (horizontally first, then vertically).
+/// The entity stops at the contact with the obstacle in the way (see `sweepBox`).
+/// </summary>
+/// <param name="entities">Container of the entity.</param>
+/// <param name="index">Index of the entity.</param>
+/// <param name="distance">Offset to move the entity.</param>
+/// <returns>Returns `true` if whole movement is possible, else `false` (entity stopped at the obstacle).</returns>
+bool Level::moveEntity(EntityStore& entities, std::size_t index, sf::Vector2f distance)
+{
+	if (distance.x != 0)
 	{
-		livObject.jump(speed, true);
-		if (this->checkObstacleCollision(livObject))
-		// Movement not possible (obstacle there) -> move to init position
-		{
-			livObject.fall(speed, true);
+		const SweepHit hit = this->sweepBox(entities.getBounds(index), { distance.x, 0 });
+		entities.move(index, hit.offset);
+		if (hit.hit)
 			return false;
-		}
-		return true;
 	}
 
-	// Staying at same relative coordinates.
-	livObject.jump(speed, false);
-	if (this->checkObstacleCollision(livObject))
-	// Movement not possible (obstacle there) -> move to init position
+	if (distance.y != 0)
 	{
-		livObject.fall(speed, false);
-		return false;
+		const SweepHit hit = this->sweepBox(entities.getBounds(index), { 0, distance.y });
+		entities.move(index, hit.offset);
+		if (hit.hit)
+			return false;
 	}
+
 	return true;
 }
 
-
 /// <summary>
-/// Tries to move `livObject` down by the offset `speed`.
+/// Sweeps the bounding box along one axis through the merged obstacles and finds the first obstacle in the way
+/// (only the lines of cells in front of the box reached by the movement are checked, so fast objects can't skip 
+/// thin obstacles). Box touching the obstacle after the movement does not collide.
 /// </summary>
-/// <param name="livObject">Object to move.</param>
-/// <param name="speed">Offset to move the object.</param>
-/// <returns>Returns `true` if movement is possible, else `false`.</returns>
-bool Level::fallLivingObject(LivingObject& livObject, float speed)
+/// <param name="bounds">Bounding box to move (absolute coordinates, not colliding with obstacles).</param>
+/// <param name="distance">Offset of the movement (only one nonzero component).</param>
+/// <returns>Returns time of the impact, normal of the hit side and the offset to move the box
+/// (whole `distance` if there is no obstacle in the way).</returns>
+SweepHit Level::sweepBox(const sf::FloatRect& bounds, sf::Vector2f distance)
 {
-	// Coordinates of the border to check (of obstacle). 
-	auto prevBottomBorderAbs = this->convertRowFromRelToAbsolute(
-								livObject.bottomBorderRel_) + this->obstacleSize_.y;
-
-	if (livObject.absObject_.getBottomBorder() + speed > prevBottomBorderAbs)
-	// It is neccesary to leave actual relative coordinates
+	SweepHit hit;
+	hit.offset = distance;
+
+	const bool horizontal = distance.x != 0;
+	const float movement = horizontal ? distance.x : distance.y;
+	if (movement == 0)
+		return hit;
+
+	// Box and cells along and across the movement.
+	const float cellSize = horizontal ? this->obstacleSize_.x : this->obstacleSize_.y;
+	const float acrossCellSize = horizontal ? this->obstacleSize_.y : this->obstacleSize_.x;
+	const float start = horizontal ? bounds.left : bounds.top;
+	const float size = horizontal ? bounds.width : bounds.height;
+	const float acrossStart = horizontal ? bounds.top : bounds.left;
+	const float acrossEnd = horizontal ? bounds.top + bounds.height : bounds.left + bounds.width;
+
+	// Cells overlapping the box across the movement (touching cells do not overlap).
+	const int firstAcross = static_cast<int>(std::floor(acrossStart / acrossCellSize));
+	const int lastAcross = static_cast<int>(std::ceil(acrossEnd / acrossCellSize)) - 1;
+
+	// Lines of the cells in front of the box reached by the movement (nearest first).
+	int firstLine, lastLine, step;
+	if (movement > 0)
 	{
-		livObject.fall(speed, true);
-		if (this->checkObstacleCollision(livObject))
-		// Movement not possible (obstacle there) -> move to init position
-		{
-			livObject.jump(speed, true);
-			livObject.fall(prevBottomBorderAbs - livObject.absObject_.getBottomBorder(), false);
-			return false;
-		}
-		return true;
+		firstLine = static_cast<int>(std::ceil((start + size) / cellSize));
+		lastLine = static_cast<int>(std::ceil((start + size + movement) / cellSize)) - 1;
+		step = 1;
+	}
+	else
+	{
+		firstLine = static_cast<int>(std::floor(start / cellSize)) - 1;
+		lastLine = static_cast<int>(std::floor((start + movement) / cellSize));
+		step = -1;
 	}
 
-	// Staying at same relative coordinates.
-	livObject.fall(speed, false);
-	if (this->checkObstacleCollision(livObject))
-	// Movement not possible (obstacle there) -> move to init position
+	// Nearest line with an obstacle (merged rectangles in the way are tested, not each cell).
+	int line;
+	if (!this->solidColliders_.findNearestLine(horizontal, firstAcross, lastAcross, step, firstLine, lastLine, line))
+		return hit;
+
+	// Obstacle found -> stop at its near side.
+	float travel;
+	if (movement > 0)
 	{
-		livObject.jump(speed, false);
-		livObject.fall(prevBottomBorderAbs - livObject.absObject_.getBottomBorder(), false);
-		return false;
+		const float side = line * cellSize;
+		travel = side - size - start;
+		// Rounding must not move the box into the obstacle.
+		while (start + travel + size > side)
+			travel = std::nextafter(travel, -std::numeric_limits<float>::infinity());
 	}
-	return true;
+	else
+	{
+		const float side = (line + 1) * cellSize;
+		travel = side - start;
+		while (start + travel < side)
+			travel = std::nextafter(travel, std::numeric_limits<float>::infinity());
+	}
+
+	hit.hit = true;
+	hit.time = std::max(0.0f, travel / movement);
+	hit.normal = horizontal ? sf::Vector2f(-static_cast<float>(step), 0) : sf::Vector2f(0, -static_cast<float>(step));
+	hit.offset = horizontal ? sf::Vector2f(travel, 0) : sf::Vector2f(0, travel);
+	return hit;
 }
 
 
@@ -330,21 +455,17 @@ bool Level::fallLivingObject(LivingObject& livObject, float speed)
 /// <returns>Returns `true` if object collides with obstacle object, else `false`.</returns>
 bool Level::checkObstacleCollision(LivingObject& livObject)
 {
-	// Choose only neighbour coordinates to check the collision.
-	auto bordersToCheck = this->getBordersToCheck(livObject);
-
-	for (auto&& border : bordersToCheck)
-	{
-		if (this->allObstacles_.find(border) != this->allObstacles_.end())
-		// On this coordinate is an obstacle.
-		{
-			// Check obstacle collision.
-			if (livObject.isCollidingWithObject(this->allObstacles_.find(border)->second.absObject_))
-				return true;
-		}
-	}
+	return this->solidColliders_.checkOverlap(livObject.absObject_.winObject_.getGlobalBounds());
+}
 
-	return false;
+/// <summary>
+/// Checks wheter the bounding box collides with some obstacle object. 
+/// </summary>
+/// <param name="bounds">Bounding box to check (absolute coordinates).</param>
+/// <returns>Returns `true` if the box collides with obstacle object, else `false`.</returns>
+bool Level::checkObstacleCollision(const sf::FloatRect& bounds)
+{
+	return this->solidColliders_.checkOverlap(bounds);
 }
 
 /// <summary>
@@ -354,24 +475,33 @@ bool Level::checkObstacleCollision(LivingObject& livObject)
 /// <returns>Returns `true` if object collides with coin object, else `false`.</returns>
 bool Level::checkCoinCollision(LivingObject& livObject)
 {
-	auto bordersToCheck = this->getBordersToCheck(livObject);
-	for (auto&& border : bordersToCheck)
+	int row, column;
+	if (this->findCollidingTile(livObject, TILE_COIN, row, column))
+	// Coin collected -> mark it and remove it from displayed objects.
 	{
-		if (this->allCoins_.find(border) != this->allCoins_.end())
-		// On this coordinate is a coin.
-		{
-			// Check coin collision.
-			if (livObject.isCollidingWithObject(this->allCoins_.find(border)->second.absObject_))
-			{
-				this->allCoins_.erase(border);
-				return true;
-			}
-		}
+		const auto cell = static_cast<std::uint64_t>(this->convertCoordinatesToInt(row, column));
+		this->collectedCoins_.insert(
+			std::lower_bound(this->collectedCoins_.begin(), this->collectedCoins_.end(), cell), cell);
+		if (this->chunks_)
+			this->chunks_->removeCoin(row, column);
+		return true;
 	}
 	return false;
 }
 
 
+/// <summary>
+/// Rebuilds the broadphase of the collisions from the actual positions of the enemies and the player
+/// (called after the movement of the enemies, before the collisions of the tick are checked).
+/// </summary>
+/// <param name="player">Player object.</param>
+void Level::updateCollisionGrid(LivingObject& player)
+{
+	this->enemyGrid_.build(this->allEnemies_);
+	this->playerBounds_ = player.absObject_.winObject_.getGlobalBounds();
+	this->playerCells_ = this->enemyGrid_.getCellRange(this->playerBounds_);
+}
+
 /// <summary>
 /// Checks whether player collides with enemy. 
 /// If so kills either player (not enough high) or enemy (player is high enough).
@@ -381,25 +511,22 @@ bool Level::checkCoinCollision(LivingObject& livObject)
 /// else `false` (enemy killed or no collision).</returns>
 bool Level::checkEnemyPlayerCollistion(LivingObject& player)
 {
-	for (auto it = this->allEnemies_.begin(); it != this->allEnemies_.end(); it++)
-	// Check all enemies for collision.
+	std::size_t enemy;
+	if (this->findCollidingEnemy(player.absObject_.winObject_.getGlobalBounds(), enemy, this->collisionQuery_))
+	// Enemy-player collision
 	{
-		if (player.isCollidingWithObject(it->absObject_))
-		// Enemy-player collision
+		if (player.absObject_.getBottomBorder() <= this->allEnemies_.positionY_[enemy] + 
+			2 * this->allEnemies_.halfExtentY_[enemy] - this->obstacleSize_.y / 2)
+		// Player high enough to kill the enemy.
 		{
-			if (player.absObject_.getBottomBorder() <=
-				it->absObject_.getBottomBorder() - this->obstacleSize_.y / 2)
-			// Player high enough to kill the enemy.
-			{
-				std::cout << "Enemy is death" << std::endl;
-				this->allEnemies_.erase(it);
-				return false;
-			}
-			else
-			// Player not high enough -> player is killed
-			{
-				return true;
-			}
+			std::cout << "Enemy is death" << std::endl;
+			this->killEnemy(enemy);
+			return false;
+		}
+		else
+		// Player not high enough -> player is killed
+		{
+			return true;
 		}
 	}
 
@@ -407,30 +534,63 @@ bool Level::checkEnemyPlayerCollistion(LivingObject& player)
 }
 
 /// <summary>
-/// Checks whether some enemy collides with the `bullet`. If so does proper action.
+/// Finds the first living enemy colliding with the bullet (no action is done).
+/// Can be called from more threads at once (each with its own query buffers).
 /// </summary>
-/// <param name="bullet">Bullet object to check.</param>
+/// <param name="bullets">Container of the bullet.</param>
+/// <param name="index">Index of the bullet to check.</param>
+/// <param name="enemy">Index of the found enemy.</param>
+/// <param name="query">Buffers of the grid query.</param>
 /// <returns>Returns `true` if bullet collides with some enemy, else `false`.</returns>
-bool Level::checkEnemyBulletCollision(Bullet& bullet)
+bool Level::findEnemyBulletCollision(const EntityStore& bullets, std::size_t index, std::size_t& enemy, 
+									GridQuery& query) const
 {
-	for (auto enemy = this->allEnemies_.begin(); enemy != this->allEnemies_.end(); enemy++)
+	return this->findCollidingEnemy(bullets.getBounds(index), enemy, query);
+}
+
+/// <summary>
+/// Does proper action for the bullet colliding with the enemy found by `findEnemyBulletCollision`.
+/// If the enemy was killed in the meantime, the next living colliding enemy is searched 
+/// (same result as if the collision was searched just now).
+/// </summary>
+/// <param name="bullets">Container of the bullet.</param>
+/// <param name="index">Index of the bullet.</param>
+/// <param name="enemy">Index of the enemy found by `findEnemyBulletCollision`.</param>
+/// <returns>Returns `true` if bullet collides with some living enemy, else `false`.</returns>
+bool Level::applyEnemyBulletCollision(const EntityStore& bullets, std::size_t index, std::size_t enemy)
+{
+	if (!(this->allEnemies_.flags_[enemy] & ENTITY_FLAG_DEAD) ||
+		this->findCollidingEnemy(bullets.getBounds(index), enemy, this->collisionQuery_))
+	// Bullet colliding with enemy.
 	{
-		if (bullet.isCollidingWithObject(enemy->absObject_))
-		// Bullet colliding with enemy.
+		if (bullets.flags_[index] & ENTITY_FLAG_STRONG)
+		// bullet is strong, then kill the enemy
 		{
-			if (bullet.isStrong())
-			// bullet is strong, then kill the enemy
-			{
-				this->allEnemies_.erase(enemy);
-			}
-
-			return true;
+			this->killEnemy(enemy);
 		}
+
+		return true;
 	}
 
 	return false;
 }
 
+/// <summary>
+/// Checks whether the bullet hits the player (only bullets in the cells of the player are checked).
+/// Player position is taken from the last `updateCollisionGrid` (can be called from more threads at once).
+/// </summary>
+/// <param name="bullets">Container of the bullet.</param>
+/// <param name="index">Index of the bullet to check.</param>
+/// <returns>Returns `true` if bullet collides with the player, else `false`.</returns>
+bool Level::checkPlayerBulletCollision(const EntityStore& bullets, std::size_t index) const
+{
+	const sf::FloatRect bulletBounds = bullets.getBounds(index);
+	if (!this->playerCells_.intersects(this->enemyGrid_.getCellRange(bulletBounds)))
+		return false;
+
+	return this->playerBounds_.intersects(bulletBounds);
+}
+
 /// <summary>
 /// Checks whether player reached the finish.
 /// </summary>
@@ -438,20 +598,8 @@ bool Level::checkEnemyBulletCollision(Bullet& bullet)
 /// <returns>Returns `true` if player reached the finish, else `false`.</returns>
 bool Level::checkFinishCollistion(Player& player)
 {
-	// Search only neighbour relative coordinates.
-	auto bordersToCheck = this->getBordersToCheck(player);
-	for (auto&& border : bordersToCheck)
-	{
-		if (this->finishPositions_.find(border) != this->finishPositions_.end())
-		// On searche position is finish object.
-		{
-			// Check if player reach the finish.
-			if (player.isCollidingWithObject(this->finishPositions_.find(border)->second.absObject_))
-				return true;
-		}
-	}
-
-	return false;
+	int row, column;
+	return this->findCollidingTile(player, TILE_FINISH, row, column);
 }
 
 /// <summary>
@@ -487,6 +635,25 @@ bool Level::checkObjectLeftMap(LivingObject& object)
 	return false;
 }
 
+/// <summary>
+/// Checks whether the entity left the map (outside the relative coordinates).
+/// </summary>
+/// <param name="entities">Container of the entity.</param>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Checks whether entity left game map, if so return `true`, else `false`</returns>
+bool Level::checkObjectLeftMap(const EntityStore& entities, std::size_t index)
+{
+	const float left = entities.positionX_[index];
+	const float top = entities.positionY_[index];
+	if (top > this->bottomMapBorder_ ||
+		top + 2 * entities.halfExtentY_[index] < 0 ||
+		left + 2 * entities.halfExtentX_[index] < 0 ||
+		left > this->rightMapBorder_)
+		return true;
+
+	return false;
+}
+
 /// <summary>
 /// Checks whether left part of the `livObject` is in empty space (no ground under it).
 /// </summary>
@@ -498,7 +665,25 @@ bool Level::checkLeftEdgeFall(LivingObject& livObject)
 	if (livObject.leftBorderRel_ < 0 || livObject.bottomBorderRel_ >= this->height_ - 1)
 		return true;
 
-	return !(this->charMap_[livObject.bottomBorderRel_ +1 ][livObject.leftBorderRel_] == this->obstacleCell_);
+	return !this->tileGrid_->hasFlag(livObject.bottomBorderRel_ + 1, livObject.leftBorderRel_, TILE_OBSTACLE);
+}
+
+/// <summary>
+/// Checks whether left part of the entity is in empty space (no ground under it).
+/// </summary>
+/// <param name="entities">Container of the entity.</param>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns `true` if to the left is no ground, else `false`.</returns>
+bool Level::checkLeftEdgeFall(const EntityStore& entities, std::size_t index)
+{
+	const int leftColumn = this->convertColumnFromAbsToRel(entities.positionX_[index]);
+	const int bottomRow = this->convertRowFromAbsToRel(entities.positionY_[index] + 2 * entities.halfExtentY_[index]);
+
+	// check index oveflow
+	if (leftColumn < 0 || bottomRow >= this->height_ - 1)
+		return true;
+
+	return !this->tileGrid_->hasFlag(bottomRow + 1, leftColumn, TILE_OBSTACLE);
 }
 
 
@@ -513,122 +698,182 @@ bool Level::checkRightEdgeFall(LivingObject& livObject)
 	if (livObject.rightBorderRel_ >= this->width_ || livObject.bottomBorderRel_ >= this->height_ - 1)
 		return true;
 
-	return !(this->charMap_[livObject.bottomBorderRel_ + 1][livObject.rightBorderRel_] == this->obstacleCell_);
+	return !this->tileGrid_->hasFlag(livObject.bottomBorderRel_ + 1, livObject.rightBorderRel_, TILE_OBSTACLE);
+}
+
+/// <summary>
+/// Checks whether right part of the entity is in empty space (no ground under it).
+/// </summary>
+/// <param name="entities">Container of the entity.</param>
+/// <param name="index">Index of the entity.</param>
+/// <returns>Returns `true` if to the right is no ground, else `false`.</returns>
+bool Level::checkRightEdgeFall(const EntityStore& entities, std::size_t index)
+{
+	const int rightColumn = this->convertColumnFromAbsToRel(entities.positionX_[index] + 2 * entities.halfExtentX_[index]);
+	const int bottomRow = this->convertRowFromAbsToRel(entities.positionY_[index] + 2 * entities.halfExtentY_[index]);
+
+	// check index oveflow
+	if (rightColumn >= this->width_ || bottomRow >= this->height_ - 1)
+		return true;
+
+	return !this->tileGrid_->hasFlag(bottomRow + 1, rightColumn, TILE_OBSTACLE);
 }
 
 
 // Private functions:
 
 /// <summary>
-/// Reads map reprezentaion from given stream and stores all neccesary info about it.
+/// Sets sizes of the level objects and default values of the variables.
 /// </summary>
-/// <param name="stream">Stream to read map from.</param>
-/// <param name="player">Player object from the game.</param>
-/// <returns>Returns `true` if reading was succesful, else `false`.</returns>
-bool Level::readMapRepresentation(std::ifstream& stream, Player& player)
+void Level::initSizes()
 {
-	std::string line;
-	for (int i = 0; i < this->height_; i++)
-	// Read rows
-	{
-		// Bad inputs -> error
-		if (!(std::getline(stream, line))) return false;
-		if ((int)line.size() < this->width_) return false;
+	// Sizes setup:
+	this->obstacleSize_ = {40, 40};
+	this->coinSize_ = { 40, 40 };
+	this->enemySize_ = { 40, 40 };
+	this->bulletSize_ = { 40, 10 };
 
-		auto row = std::vector<char>(this->width_);
-		fill(row.begin(), row.end(), this->emptyCell_);
-		this->charMap_.push_back(std::move(row));
+	// Object variables init:
+	this->error_ = false;
+	this->bottomMapBorder_ = 0;
+	this->rightMapBorder_ = 0;
+	this->startPlayerPosition_ = { 0, 0 };
 
-		for (int j = 0; j < this->width_; j++)
-		// Check each collumn in row.
-		{
-			char actCell = line[j];
+	this->initColors();
+}
 
-			// Symbol not known.
-			if (actCell != this->emptyCell_ && actCell != this->obstacleCell_ &&
-				actCell != this->playerCell_ && actCell != this->coinCell_ &&
-				actCell != this->enemyCell_ && actCell != this->finishCell_)
-				return false;
+/// <summary>
+/// Sets colors of the entities.
+/// </summary>
+void Level::initColors()
+{
+	this->enemyColor_ = sf::Color::Blue;
+	this->weakBulletColor_ = sf::Color::Magenta;
+	this->strongBulletColor_ = sf::Color::White;
+}
 
-			if (actCell == this->obstacleCell_)
-			// Obstacle -> add proper reprezentation
-			{
-				this->charMap_[i][j] = this->obstacleCell_;
-				auto actObstacle = Obstacle(this->obstacleSize_);
-				actObstacle.absObject_.setPos(this->convertRelToAbsoluteCoord(i, j));
+/// <summary>
+/// Creates all the level objects from the parsed level.
+/// The parsed level is kept as the immutable template for `reset`.
+/// </summary>
+/// <param name="data">Parsed level (shared, never changed).</param>
+/// <param name="player">Player object from the game.</param>
+/// <param name="streaming">Should be the map streamed (large maps are always streamed).</param>
+/// <param name="drawable">Should be the window objects of the map built (no chunks loaded if not).</param>
+void Level::buildLevel(std::shared_ptr<const LevelData> data, Player& player, bool streaming, bool drawable)
+{
+	this->template_ = std::move(data);
 
-				this->allObstacles_.insert(std::make_pair(
-						this->convertCoordinatesToInt(i, j), std::move(actObstacle)));
-			}
+	// Init variables:
+	this->width_ = this->template_->tiles_.getWidth();
+	this->height_ = this->template_->tiles_.getHeight();
+	this->bottomMapBorder_ = this->height_ * this->obstacleSize_.y;
+	this->rightMapBorder_ = this->width_ * this->obstacleSize_.x;
+	this->collectedCoins_.clear();
+
+	// Static content (shared with the chunk loading thread, owned by the template).
+	this->tileGrid_ = std::shared_ptr<const TileGrid>(this->template_, &this->template_->tiles_);
+	this->solidColliders_.build(this->template_->solidRects_, this->width_, this->height_, this->obstacleSize_);
+
+	// Obstacles, coins and finish positions (all at once if not streaming).
+	// The objects are frozen by the same rule whether the level is drawn or not.
+	this->streaming_ = streaming ||
+		static_cast<std::int64_t>(this->width_) * this->height_ > streamingCellLimit_;
+	this->activeChunkRow_ = 0;
+	this->activeChunkColumn_ = 0;
+	if (drawable)
+	{
+		this->chunks_.reset(new ChunkStreamer(this->tileGrid_, this->obstacleSize_, this->coinSize_));
+		if (!this->streaming_)
+			this->chunks_->loadAll(*this->template_);
+	}
 
-			else if (actCell == this->playerCell_)
-			// Player -> set position of the player and init relative positon
-			{
-				this->startPlayerPosition_ = this->convertRelToAbsoluteCoord(i, j);
-				this->startPlayerRel_ = { j, i };
-				this->movePlayerToStart(player);
-			}
+	// Player start
+	if (this->template_->hasPlayer_)
+	{
+		const auto& start = this->template_->playerStart_;
+		this->startPlayerPosition_ = this->convertRelToAbsoluteCoord(start.row, start.column);
+		this->startPlayerRel_ = { start.column, start.row };
+	}
 
-			else if (actCell == this->enemyCell_)
-			// Enemy -> set position and init
-			{
-				this->charMap_[i][j] = this->enemyCell_;
-				auto actEnemy = Enemy(this->enemySize_);
-				actEnemy.absObject_.setPos(this->convertRelToAbsoluteCoord(i, j));
-				actEnemy.initRelativePos(j, i);
-				this->allEnemies_.push_back(std::move(actEnemy));
-			}
+	// Bullet pool (no allocation while playing until the pool is full).
+	this->allBullets_.reserve(bulletPoolSize_);
+	this->spawnedBullets_.reserve(bulletPoolSize_);
+	this->despawnedBullets_.reserve(bulletPoolSize_);
+	this->enemyGrid_ = EntityGrid(this->obstacleSize_);
 
-			else if (actCell == this->coinCell_)
-			// Coin set position and init
-			{
-				this->charMap_[i][j] = this->coinCell_;
-				auto actCoin = Coin(this->coinSize_);
-				actCoin.absObject_.setPos(this->convertRelToAbsoluteCoord(i, j));
-				this->allCoins_.insert(std::make_pair(
-							this->convertCoordinatesToInt(i, j), std::move(actCoin)));
-			}
+	// Enemies and player
+	this->reset(player);
+}
 
-			else if (actCell == this->finishCell_)
-			// Finish set position and init
-			{
-				this->charMap_[i][j] = this->finishCell_;
-				auto actFinish = FinishLine(this->obstacleSize_);
-				actFinish.absObject_.setPos(this->convertRelToAbsoluteCoord(i, j));
-				this->finishPositions_.insert(std::make_pair(
-							this->convertCoordinatesToInt(i, j), actFinish));
-			}
 
-		}
+/// <summary>
+/// Rebuilds the spatial index of the entities and finds the entities overlapping the area
+/// (stored to `visibleObjects_` in the order of the container).
+/// </summary>
+/// <param name="entities">Entities to check.</param>
+/// <param name="index">Spatial index of the entities.</param>
+/// <param name="area">Displayed area (absolute coordinates).</param>
+void Level::findVisibleObjects(const EntityStore& entities, SpatialIndex& index, const sf::FloatRect& area)
+{
+	index.clear();
+	for (std::size_t i = 0; i < entities.size(); i++)
+	{
+		index.insert(static_cast<std::uint32_t>(i), entities.getBounds(i));
 	}
 
-	return true;
+	// Found entities are sorted -> same drawing order as in the container.
+	index.query(area, this->visibleObjects_);
+	this->visibleObjects_.erase(std::remove_if(this->visibleObjects_.begin(), this->visibleObjects_.end(),
+		[&](std::uint32_t i) { return !entities.isOverlapping(i, area); }), this->visibleObjects_.end());
 }
 
+/// <summary>
+/// Adds the entity rotated in the direction of its movement to the batch.
+/// </summary>
+/// <param name="entities">Container of the entity.</param>
+/// <param name="index">Index of the entity.</param>
+/// <param name="size">Size of the entity (not rotated).</param>
+/// <param name="color">Color of the entity.</param>
+/// <param name="alpha">Render interpolation between the previous and the actual tick.</param>
+/// <param name="batch">Batch where to add the entity.</param>
+void Level::addEntity(const EntityStore& entities, std::size_t index, sf::Vector2f size,
+						const sf::Color& color, float alpha, SpriteBatch& batch)
+{
+	sf::Vector2f direction(1.0f, 0.0f);
+	const sf::Vector2f velocity = entities.getVelocity(index);
+	float length = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+	if (length > 0.0f)
+		direction = velocity / length;
+
+	const sf::Vector2f center = entities.getPosition(index) + entities.getHalfExtent(index) +
+		entities.getInterpolationOffset(index, alpha);
+	batch.add(center, size, direction, color);
+}
 
 /// <summary>
-/// Converts 2D coordinate to `int` representation (for map storage).
+/// Converts 2D coordinate to 64-bit representation (for map storage).
 /// Convertion algorithm:		result = row * map_width + column;
 /// </summary>
 /// <param name="row">Relative row coordinate.</param>
 /// <param name="column">Relative column coordinate.</param>
-/// <returns>Returns `int` representation of the give coordinates.</returns>
-int Level::convertCoordinatesToInt(int row, int column)
+/// <returns>Returns 64-bit representation of the give coordinates.</returns>
+std::int64_t Level::convertCoordinatesToInt(int row, int column)
 {
-	return row * this->width_ + column;
+	return static_cast<std::int64_t>(row) * this->width_ + column;
 }
 
 
 /// <summary>
-/// Converts from `int` coordinate representation to 2D representation.
+/// Converts from 64-bit coordinate representation to 2D representation.
 /// Convertion algorithm:		row = coordInt / map_width
 ///								column = coordInt % map_width
 /// </summary>
 /// <param name="coordInt">Integer representation of 2D map coordinates.</param>
 /// <returns>Returns 2D coordinates { row, column }.</returns>
-sf::Vector2i Level::convertIntToCoordinates(int coordInt)
+sf::Vector2i Level::convertIntToCoordinates(std::int64_t coordInt)
 {
-	return { coordInt / this->width_, coordInt % this->width_ };
+	return { static_cast<int>(coordInt / this->width_), static_cast<int>(coordInt % this->width_) };
 }
 
 /// <summary>
@@ -664,26 +909,150 @@ sf::Vector2f Level::convertRelToAbsoluteCoord(int row, int column)
 			this->convertRowFromRelToAbsolute(row) };
 }
 
+/// <summary>
+/// Converts absolute coordinate to relative (same convention as the relative borders of `LivingObject`,
+/// coordinate on the border of two cells belongs to the left one).
+/// </summary>
+/// <param name="x">Absolute coordinate to convert.</param>
+/// <returns>Column of the cell containing the coordinate.</returns>
+int Level::convertColumnFromAbsToRel(float x)
+{
+	return static_cast<int>(std::ceil(x / this->obstacleSize_.x)) - 1;
+}
 
 /// <summary>
-/// Finds relative neighbour coordinates of the given object (for collistion detection).
+/// Converts absolute coordinate to relative (same convention as the relative borders of `LivingObject`,
+/// coordinate on the border of two cells belongs to the upper one).
+/// </summary>
+/// <param name="y">Absolute coordinate to convert.</param>
+/// <returns>Row of the cell containing the coordinate.</returns>
+int Level::convertRowFromAbsToRel(float y)
+{
+	return static_cast<int>(std::ceil(y / this->obstacleSize_.y)) - 1;
+}
+
+/// <summary>
+/// Sets relative borders of `livObject` from its absolute position (after the movement).
+/// </summary>
+/// <param name="livObject">Object to update.</param>
+void Level::updateRelativePos(LivingObject& livObject)
+{
+	const sf::FloatRect bounds = livObject.absObject_.winObject_.getGlobalBounds();
+	livObject.leftBorderRel_ = this->convertColumnFromAbsToRel(bounds.left);
+	livObject.rightBorderRel_ = this->convertColumnFromAbsToRel(bounds.left + bounds.width);
+	livObject.topBorderRel_ = this->convertRowFromAbsToRel(bounds.top);
+	livObject.bottomBorderRel_ = this->convertRowFromAbsToRel(bounds.top + bounds.height);
+}
+
+/// <summary>
+/// Checks whether the cell lies in the active area (at most `activeChunkRadius_` chunks from the player).
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <returns>Returns `true` if the cell is active (always if not streaming), else `false`.</returns>
+bool Level::isCellActive(int row, int column) const
+{
+	if (!this->streaming_)
+		return true;
+
+	return std::abs(ChunkStreamer::getChunkIndex(row) - this->activeChunkRow_) <= activeChunkRadius_ &&
+		std::abs(ChunkStreamer::getChunkIndex(column) - this->activeChunkColumn_) <= activeChunkRadius_;
+}
+
+
+/// <summary>
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <returns>Returns absolute boundaries of the cell on the given relative coordinates.</returns>
+sf::FloatRect Level::getTileBounds(int row, int column)
+{
+	return sf::FloatRect(this->convertRelToAbsoluteCoord(row, column), this->obstacleSize_);
+}
+
+/// <summary>
+/// Checks whether the cell contains given static content (collected coins are not present).
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <param name="tileFlag">Content to check (`TileFlag` value).</param>
+/// <returns>Returns `true` if the cell contains the content, else `false`.</returns>
+bool Level::hasTile(int row, int column, std::uint8_t tileFlag)
+{
+	if (!this->tileGrid_->hasFlag(row, column, tileFlag))
+		return false;
+
+	if (tileFlag == TILE_COIN)
+		return !this->isCoinCollected(row, column);
+
+	return true;
+}
+
+/// <summary>
+/// Finds the neighbour cell (only cells covered by relative coordinates of the object) 
+/// containing `tileFlag` content which collides with `livObject`.
 /// </summary>
 /// <param name="livObject">Object to check.</param>
-/// <returns>Returns vector of relative neighbour coordinates in `int` form.</returns>
-std::vector<int> Level::getBordersToCheck(LivingObject& livObject)
+/// <param name="tileFlag">Content of the cells to check (`TileFlag` value).</param>
+/// <param name="row">Relative row coordinate of the found cell.</param>
+/// <param name="column">Relative column coordinate of the found cell.</param>
+/// <returns>Returns `true` if colliding cell was found, else `false`.</returns>
+bool Level::findCollidingTile(LivingObject& livObject, std::uint8_t tileFlag, int& row, int& column)
 {
+	const sf::FloatRect objectBounds = livObject.absObject_.winObject_.getGlobalBounds();
+
 	// Relative coordinates of all the sides of the searched object.
-	int left = livObject.leftBorderRel_;
-	int right = livObject.rightBorderRel_;
-	int top = livObject.topBorderRel_;
-	int bottom = livObject.bottomBorderRel_;
-
-	// Get the coordinates to check.
-	std::vector<int> bordersToCheck;
-	bordersToCheck.push_back(this->convertCoordinatesToInt(top, left));				// (-1, -1)
-	bordersToCheck.push_back(this->convertCoordinatesToInt(top, right));			// (-1, 0)
-	bordersToCheck.push_back(this->convertCoordinatesToInt(bottom, left));			// (0, -1)
-	bordersToCheck.push_back(this->convertCoordinatesToInt(bottom, right));			// (0, 0)
-
-	return bordersToCheck;
-}
\ No newline at end of file
+	const int rowsToCheck[] = { livObject.topBorderRel_, livObject.bottomBorderRel_ };
+	const int columnsToCheck[] = { livObject.leftBorderRel_, livObject.rightBorderRel_ };
+
+	for (int actRow : rowsToCheck)
+	{
+		for (int actColumn : columnsToCheck)
+		{
+			if (this->hasTile(actRow, actColumn, tileFlag) &&
+				objectBounds.intersects(this->getTileBounds(actRow, actColumn)))
+			// Cell with searched content collides with the object.
+			{
+				row = actRow;
+				column = actColumn;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/// <summary>
+/// Marks the enemy as killed, it is removed at the end of the tick (indices of the collision grid stay valid).
+/// </summary>
+/// <param name="index">Index of the enemy.</param>
+void Level::killEnemy(std::size_t index)
+{
+	this->allEnemies_.flags_[index] |= ENTITY_FLAG_DEAD;
+	this->killedEnemies_.push_back(this->allEnemies_.getHandle(index));
+}
+
+/// <summary>
+/// Finds the first living enemy (in the order of the container) colliding with the bounding box.
+/// Only enemies from the cells of the collision grid overlapping the box are checked (batch test).
+/// </summary>
+/// <param name="bounds">Bounding box to check (absolute coordinates).</param>
+/// <param name="enemy">Index of the found enemy.</param>
+/// <param name="query">Buffers of the grid query.</param>
+/// <returns>Returns `true` if colliding enemy was found, else `false`.</returns>
+bool Level::findCollidingEnemy(const sf::FloatRect& bounds, std::size_t& enemy, GridQuery& query) const
+{
+	// Colliding enemies are sorted -> same enemy as if all the enemies were checked.
+	this->enemyGrid_.query(bounds, query);
+	for (auto candidate : query.result)
+	{
+		if (!(this->allEnemies_.flags_[candidate] & ENTITY_FLAG_DEAD))
+		{
+			enemy = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
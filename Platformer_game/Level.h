@@ -6,16 +6,46 @@
 #include<string>
 #include<fstream>
 #include<sstream>
+#include<memory>
+#include<cmath>
+#include<algorithm>
+#include<limits>
 
 #include "SFML_includes.h"
 #include "Obstacle.h"
 #include "Player.h"
 #include "Coin.h"
-#include "Enemy.h"
+#include "EntityStore.h"
 #include "FinishLine.h"
+#include "TileGrid.h"
+#include "LevelData.h"
+#include "ChunkStreamer.h"
+#include "SpatialIndex.h"
+#include "EntityGrid.h"
+#include "ColliderGrid.h"
+#include "SpriteBatch.h"
+
+// Bullet waiting for the end of the tick to be added to the pool.
+struct BulletSpawn
+{
+	sf::Vector2f position;
+	sf::Vector2f halfExtent;
+	sf::Vector2f velocity;
+	std::uint8_t flags = ENTITY_FLAG_NONE;
+};
 
-// for reprezenting level map
-using vectorChar2D = std::vector<std::vector<char>>;
+// Result of the swept movement of the bounding box (see `Level::sweepBox`).
+struct SweepHit
+{
+	// Flag if some obstacle is in the way.
+	bool hit = false;
+	// Part of the movement done before the contact (`1` if there is no obstacle).
+	float time = 1.0f;
+	// Normal of the hit side of the obstacle (zero if there is no obstacle).
+	sf::Vector2f normal;
+	// Offset to move the box (to the contact position).
+	sf::Vector2f offset;
+};
 
 class Level
 {
@@ -28,57 +58,69 @@ public:
 	int height_ = 0;
 	int width_ = 0;
 
-	// Relative map reprezentation:
-	vectorChar2D charMap_;
+	// Relative map reprezentation 
+	// (static content of each cell, obstacles are collided through the merged rectangles `solidColliders_`).
+	std::shared_ptr<const TileGrid> tileGrid_;
 
 	// Intial functions and setup functions:
 	Level();
-	Level(const std::string& filename, Player& player);
+	Level(const std::string& filename, Player& player, bool streaming = false, bool drawable = true);
+	Level(std::shared_ptr<const LevelData> data, Player& player, bool drawable = true);
 
-	bool loadMap(const std::string& filename, Player& player);
+	bool loadMap(const std::string& filename, Player& player, bool streaming, bool drawable);
+	void reset(Player& player);
 	void movePlayerToStart(Player& player);
-	void addBullet(Bullet&& bullet);
+	bool spawnBullet(sf::Vector2f center, sf::Vector2f velocity, bool strong);
+	void despawnBullet(std::size_t index);
+	void applyEntityChanges();
 
-	// Display function:
-	void drawMap(sf::RenderWindow& window);
+	// Display functions:
+	void drawMap(SpriteBatch& batch, const sf::FloatRect& viewBounds, float alpha = 1.0f);
+	void savePreviousPositions();
+
+	// Streaming functions:
+	void updateActiveArea(LivingObject& player);
+	void updateStreaming(sf::Vector2f center, sf::Vector2f viewSize);
+	bool isObjectActive(LivingObject& object);
+	bool isObjectActive(const EntityStore& entities, std::size_t index);
 
 	// Functions to return level objects:
 	const sf::Vector2f& getObstacleSize();
-	const std::map<int, Obstacle>& getAllObstacles();
-	std::vector<Enemy>& getAllEnemies(); 
-	std::vector<Bullet>& getAllWeakBullets();
-	std::vector<Bullet>& getAllStrongBullets();
+	const sf::Vector2f& getBulletSize();
+	bool isCoinCollected(int row, int column);
+	EntityStore& getAllEnemies(); 
+	EntityStore& getAllBullets();
 
 	// Functions for object movent:
-	bool moveLivingObjectLeft(LivingObject& livObject, float speed);
-	bool moveLivingObjectRight(LivingObject& livObject, float speed);
-	bool jumpLivingObject(LivingObject& livObject, float speed);
-	bool fallLivingObject(LivingObject& livObject, float speed);
+	bool moveLivingObject(LivingObject& livObject, sf::Vector2f distance);
+	bool moveEntity(EntityStore& entities, std::size_t index, sf::Vector2f distance);
+	SweepHit sweepBox(const sf::FloatRect& bounds, sf::Vector2f distance);
 
 	// Functions to check map events:
+	void updateCollisionGrid(LivingObject& player);
 	bool checkObstacleCollision(LivingObject& livObject);
+	bool checkObstacleCollision(const sf::FloatRect& bounds);
 	bool checkCoinCollision(LivingObject& livObject);
 	bool checkEnemyPlayerCollistion(LivingObject& player);
-	bool checkEnemyBulletCollision(Bullet& bullet);
+	bool findEnemyBulletCollision(const EntityStore& bullets, std::size_t index, std::size_t& enemy, 
+								GridQuery& query) const;
+	bool applyEnemyBulletCollision(const EntityStore& bullets, std::size_t index, std::size_t enemy);
+	bool checkPlayerBulletCollision(const EntityStore& bullets, std::size_t index) const;
 	bool checkFinishCollistion(Player& player);
 	bool checkPlayerFellOfMap(LivingObject& player);
 	bool checkObjectLeftMap(LivingObject& object);
+	bool checkObjectLeftMap(const EntityStore& entities, std::size_t index);
 	bool checkLeftEdgeFall(LivingObject& livObject);
+	bool checkLeftEdgeFall(const EntityStore& entities, std::size_t index);
 	bool checkRightEdgeFall(LivingObject& livObject);
+	bool checkRightEdgeFall(const EntityStore& entities, std::size_t index);
 
 private:
-	// Static symbols for map reprezentation:
-	static const char emptyCell_ = '.';
-	static const char obstacleCell_ = '#';
-	static const char playerCell_ = 'P';
-	static const char enemyCell_ = 'E';
-	static const char coinCell_ = 'C';
-	static const char finishCell_ = 'F';
-
 	// Sizes of the level objects:
 	sf::Vector2f obstacleSize_;
 	sf::Vector2f coinSize_;
 	sf::Vector2f enemySize_;
+	sf::Vector2f bulletSize_;
 
 	// Map borders in window coordinates (top and left are 0):
 	float bottomMapBorder_ = 0.0f;
@@ -88,28 +130,98 @@ private:
 	sf::Vector2f startPlayerPosition_;
 	sf::Vector2i startPlayerRel_;
 
-	// Containers containing all necessary map objects:
-	std::map<int, Obstacle> allObstacles_;
-	std::map<int, Coin> allCoins_;
-	std::vector<Enemy> allEnemies_;
-	std::vector<Bullet> allWeakBullets_;
-	std::vector<Bullet> allStrongBullets_;
-	std::map<int, FinishLine> finishPositions_;
+	// Size of the cells of the spatial indices (in absolute coordinates).
+	static constexpr float entityIndexCellSize_ = 320.0f;
+
+	// Number of the bullets preallocated in the pool.
+	static const std::size_t bulletPoolSize_ = 1024;
+
+	// Maps larger than this (number of cells) are always streamed.
+	static const std::int64_t streamingCellLimit_ = 1 << 22;
+
+	// Objects farther than this (in chunks) from the chunk of the player are frozen while streaming.
+	static const std::int64_t activeChunkRadius_ = 2;
+
+	// Window objects of the static content (obstacles, coins, finish) split into chunks
+	// (`nullptr` if the level is never drawn, e.g. headless simulations).
+	std::unique_ptr<ChunkStreamer> chunks_;
+	// Streamed level -> objects outside the active area are frozen (also if never drawn)
+	// and the chunks are loaded only around the view (if drawn).
+	bool streaming_ = false;
+	// Chunk of the player (center of the active area), moved once per tick.
+	std::int64_t activeChunkRow_ = 0;
+	std::int64_t activeChunkColumn_ = 0;
+
+	// Parsed level (immutable, the initial state is restored from it by `reset`).
+	std::shared_ptr<const LevelData> template_;
+
+	// Obstacles merged into large rectangles (static collisions, the per-tile grid is used by the edge checks).
+	ColliderGrid solidColliders_;
+
+	// Cell indices of the collected coins (sorted, the tile grid is not changed),
+	// memory grows with the collected coins, not with the map size.
+	std::vector<std::uint64_t> collectedCoins_;
+
+	// Containers containing all necessary map objects (components stored as arrays):
+	EntityStore allEnemies_;
+	// Weak and strong bullets (`ENTITY_FLAG_STRONG`) share one pool.
+	EntityStore allBullets_;
+
+	// Bullets spawned and destroyed and enemies killed during the tick 
+	// (applied at its end by `applyEntityChanges`).
+	std::vector<BulletSpawn> spawnedBullets_;
+	std::vector<EntityHandle> despawnedBullets_;
+	std::vector<EntityHandle> killedEnemies_;
+
+	// Broadphase of the collisions with the enemies (rebuilt each tick, cells of the map size),
+	// bounding box of the player and cells overlapped by it.
+	EntityGrid enemyGrid_;
+	sf::FloatRect playerBounds_;
+	sf::IntRect playerCells_;
+	// Buffers of the grid queries done by the main thread.
+	GridQuery collisionQuery_;
+
+	// Colors of the entities:
+	sf::Color enemyColor_;
+	sf::Color weakBulletColor_;
+	sf::Color strongBulletColor_;
+
+	// Spatial indices of the moving objects (for drawing only the visible ones):
+	SpatialIndex enemyIndex_ = SpatialIndex(entityIndexCellSize_);
+	SpatialIndex bulletIndex_ = SpatialIndex(entityIndexCellSize_);
+	std::vector<std::uint32_t> visibleObjects_;
 
 	// Initial functions:
-	bool readMapRepresentation(std::ifstream& stream, Player& player);
+	void initSizes();
+	void initColors();
+	void buildLevel(std::shared_ptr<const LevelData> data, Player& player, bool streaming, bool drawable);
 
-	// Convertion between 2D `int` coordinates and single `int` value:
-	int convertCoordinatesToInt(int row, int column);
-	sf::Vector2i convertIntToCoordinates(int coordInt);
+	// Display functions:
+	void findVisibleObjects(const EntityStore& entities, SpatialIndex& index, const sf::FloatRect& area);
+	void addEntity(const EntityStore& entities, std::size_t index, sf::Vector2f size, 
+					const sf::Color& color, float alpha, SpriteBatch& batch);
+
+	// Convertion between 2D `int` coordinates and single 64-bit value:
+	std::int64_t convertCoordinatesToInt(int row, int column);
+	sf::Vector2i convertIntToCoordinates(std::int64_t coordInt);
 
 	// Convertion between relative and absolute coordinates;
 	float convertColumnFromRelToAbsolute(int x);
 	float convertRowFromRelToAbsolute(int y);
 	sf::Vector2f convertRelToAbsoluteCoord(int row, int column);
-
-	// Getting necessary relative coordinates:
-	std::vector<int> getBordersToCheck(LivingObject& livObject);
+	int convertColumnFromAbsToRel(float x);
+	int convertRowFromAbsToRel(float y);
+	void updateRelativePos(LivingObject& livObject);
+	bool isCellActive(int row, int column) const;
+
+	// Static collision functions:
+	sf::FloatRect getTileBounds(int row, int column);
+	bool hasTile(int row, int column, std::uint8_t tileFlag);
+	bool findCollidingTile(LivingObject& livObject, std::uint8_t tileFlag, int& row, int& column);
+
+	// Dynamic collision functions:
+	void killEnemy(std::size_t index);
+	bool findCollidingEnemy(const sf::FloatRect& bounds, std::size_t& enemy, GridQuery& query) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+
+#include "../LevelData.h"
+#include "../MappedFile.h"
+
+// Compiles text level to the binary format (`.lvlc`).
+// Usage:   LevelCompiler <level.txt> [<output.lvlc>]
+// Without the output filename the level is compiled to the cache 
+// used by the game (`<level.txt>.lvlc`).
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cout << "Usage: " << argv[0] << " <level.txt> [<output.lvlc>]" << std::endl;
+        return 1;
+    }
+
+    std::string levelFile = argv[1];
+    std::string outputFile = (argc > 2) ? argv[2] : LevelData::getCacheFilename(levelFile);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Parse the text level (mapped to the memory).
+    MappedFile file;
+    if (!file.open(levelFile))
+    {
+        std::cout << "Cann't read the level file: " << levelFile << std::endl;
+        return 1;
+    }
+
+    LevelData data;
+    if (!data.parseText(file.getData(), file.getSize()))
+    {
+        std::cout << "Bad level format: " << levelFile << std::endl;
+        return 1;
+    }
+
+    // Store the compiled level (with hash of the source for the cache).
+    auto sourceHash = LevelData::computeHash(file.getData(), file.getSize());
+    if (!data.saveCompiled(outputFile, sourceHash))
+    {
+        std::cout << "Cann't write the compiled level: " << outputFile << std::endl;
+        return 1;
+    }
+
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << levelFile << " -> " << outputFile << std::endl;
+    std::cout << "Size: " << data.tiles_.getWidth() << "x" << data.tiles_.getHeight()
+              << ", obstacle rectangles: " << data.solidRects_.size()
+              << ", coins: " << data.coinCells_.size()
+              << ", finish rectangles: " << data.finishRects_.size()
+              << ", enemies: " << data.enemySpawns_.size() << std::endl;
+    std::cout << "Compiled in " << elapsedMs << " ms" << std::endl;
+
+    return 0;
+}
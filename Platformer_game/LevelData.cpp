@@ -0,0 +1,707 @@
+#include "LevelData.h"
+
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <limits>
+#include <algorithm>
+#include <thread>
+#include <functional>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEVELDATA_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+
+static_assert(sizeof(CompiledLevelHeader) == 64, "Compiled level header must not contain padding.");
+static_assert(sizeof(TileRect) == 16, "Compiled rectangle must not contain padding.");
+
+const char* const LevelData::compiledExtension_ = ".lvlc";
+
+
+/// <summary>
+/// </summary>
+/// <param name="mask">Non-zero bit mask.</param>
+/// <returns>Returns index of the lowest set bit.</returns>
+static int findLowestBit(unsigned mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+/// <summary>
+/// </summary>
+/// <param name="filename">Filename of the file to replace.</param>
+/// <returns>Returns name of the temporary file in the same directory (unique for each process and thread).</returns>
+static std::string getTemporaryFilename(const std::string& filename)
+{
+#ifdef _WIN32
+	const unsigned long processId = GetCurrentProcessId();
+#else
+	const long processId = static_cast<long>(getpid());
+#endif
+	std::ostringstream temporaryFilename;
+	temporaryFilename << filename << '.' << processId << '.'
+		<< std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+	return temporaryFilename.str();
+}
+
+/// <summary>
+/// Atomically replaces the file by the other one (readers see either the old or the new file).
+/// </summary>
+/// <param name="source">Filename of the new content (moved).</param>
+/// <param name="target">Filename of the replaced file.</param>
+/// <returns>Returns `true` if replacing was succesfull, else `false`.</returns>
+static bool replaceFile(const std::string& source, const std::string& target)
+{
+#ifdef _WIN32
+	// Fails if somebody has the target mapped (the old file is kept then).
+	return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	// Mapped old file stays valid for its readers.
+	return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+
+// Public functions:
+
+/// <summary>
+/// Loads the level from the file. Compiled levels (`.lvlc` files) are read directly,
+/// text levels are loaded through the cache of the compiled levels.
+/// </summary>
+/// <param name="filename">Filename of the level.</param>
+/// <returns>Returns `true` if loading was succesfull, else `false`.</returns>
+bool LevelData::load(const std::string& filename)
+{
+	if (isCompiledFilename(filename))
+		return this->loadCompiled(filename, false, 0);
+
+	return this->loadCached(filename);
+}
+
+/// <summary>
+/// Reads map from the text file (the file is parsed directly from the mapped bytes).
+/// </summary>
+/// <param name="filename">Filename of file with map reprezentaion.</param>
+/// <returns>Returns `true` if loading was succesfull, else `false`.</returns>
+bool LevelData::loadText(const std::string& filename)
+{
+	MappedFile file;
+	if (!file.open(filename))
+		return false;
+
+	return this->parseText(file.getData(), file.getSize());
+}
+
+/// <summary>
+/// Reads map in format:
+///			1st line :	width heigth
+///			rest :		length of the line is `width`
+///						number of lines is `height`
+///
+///			symbols:	`.` - free space
+///						`#` - obstacle
+///						`P` - player
+///						`E` - enemy
+///						`C` - coin
+///						`F` - finish
+/// </summary>
+/// <param name="data">Text reprezentation of the map.</param>
+/// <param name="size">Size of the text (in bytes).</param>
+/// <returns>Returns `true` if parsing was succesfull, else `false`.</returns>
+bool LevelData::parseText(const char* data, std::size_t size)
+{
+	this->clear();
+
+	const char* actPos = data;
+	const char* end = data + size;
+
+	// Read width and height and check if data format is ok.
+	int width = 0;
+	int height = 0;
+	if (!this->readMapHeader(actPos, end, width, height))
+	{
+		return false;
+	}
+	if (width <= 0 || height <= 0)
+	{
+		return false;
+	}
+	if (static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height) > 
+		static_cast<std::uint64_t>(end - actPos))
+	// Not enough data for all the rows.
+	{
+		return false;
+	}
+
+	// Read the map:
+	this->tiles_.reset(width, height);
+	return this->readMapRepresentation(actPos, end);
+}
+
+/// <summary>
+/// Reads map from the compiled (binary) file.
+/// </summary>
+/// <param name="filename">Filename of the compiled level.</param>
+/// <param name="checkHash">Should be the hash of the source level checked (yes - `true`, no - `false`).</param>
+/// <param name="sourceHash">Expected hash of the source level.</param>
+/// <returns>Returns `true` if loading was succesfull, else `false`
+/// (missing or damaged file, different version or source hash).</returns>
+bool LevelData::loadCompiled(const std::string& filename, bool checkHash, std::uint64_t sourceHash)
+{
+	this->clear();
+
+	MappedFile file;
+	if (!file.open(filename) || file.getSize() < sizeof(CompiledLevelHeader))
+		return false;
+
+	// Header check:
+	CompiledLevelHeader header;
+	std::memcpy(&header, file.getData(), sizeof(header));
+	if (std::memcmp(header.magic, "PLVL", 4) != 0 || header.version != compiledVersion_)
+		return false;
+	if (checkHash && header.sourceHash != sourceHash)
+		return false;
+	if (header.width <= 0 || header.height <= 0)
+		return false;
+
+	// Size check (all the sections must be present), nothing behind the header is read before it.
+	// Each cell takes one byte of the file -> section sizes computed below cannot overflow.
+	const std::uint64_t cellCount = static_cast<std::uint64_t>(header.width) *
+									static_cast<std::uint64_t>(header.height);
+	if (cellCount > file.getSize())
+		return false;
+	if (header.enemyCount > cellCount || header.solidRectCount > cellCount ||
+		header.finishRectCount > cellCount || header.coinCount > cellCount)
+		return false;
+	const std::uint64_t rectCount = header.solidRectCount + header.finishRectCount;
+	if (rectCount > cellCount)
+		return false;
+	const std::uint64_t expectedSize = sizeof(CompiledLevelHeader) + cellCount +
+				header.enemyCount * 2 * sizeof(std::int32_t) + rectCount * sizeof(TileRect) +
+				header.coinCount * sizeof(std::uint64_t);
+	if (expectedSize != file.getSize())
+		return false;
+
+	const char* actPos = file.getData() + sizeof(CompiledLevelHeader);
+
+	// Tile grid:
+	this->tiles_.reset(header.width, header.height);
+	std::memcpy(this->tiles_.getData(), actPos, static_cast<std::size_t>(cellCount));
+	actPos += cellCount;
+
+	// Spawn table:
+	this->hasPlayer_ = header.playerRow >= 0;
+	if (this->hasPlayer_)
+	{
+		if (!this->tiles_.isInside(header.playerRow, header.playerColumn))
+			return false;
+		this->playerStart_ = { header.playerRow, header.playerColumn };
+	}
+
+	this->enemySpawns_.resize(static_cast<std::size_t>(header.enemyCount));
+	for (auto&& enemy : this->enemySpawns_)
+	{
+		std::int32_t position[2];
+		std::memcpy(position, actPos, sizeof(position));
+		actPos += sizeof(position);
+
+		if (!this->tiles_.isInside(position[0], position[1]))
+			return false;
+		enemy = { position[0], position[1] };
+	}
+
+	// Merged rectangles:
+	if (!this->readRectangles(actPos, header.solidRectCount, this->solidRects_) ||
+		!this->readRectangles(actPos, header.finishRectCount, this->finishRects_))
+		return false;
+
+	// Coin table:
+	this->coinCells_.resize(static_cast<std::size_t>(header.coinCount));
+	if (header.coinCount > 0)
+		std::memcpy(this->coinCells_.data(), actPos, this->coinCells_.size() * sizeof(std::uint64_t));
+
+	for (auto cell : this->coinCells_)
+	{
+		if (cell >= cellCount)
+			return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Loads the text level through the cache of the compiled levels.
+/// If the compiled level of the same content (hash) exists, it is used,
+/// else the text level is parsed and compiled to the cache for the next loading.
+/// </summary>
+/// <param name="filename">Filename of the text level.</param>
+/// <returns>Returns `true` if loading was succesfull, else `false`.</returns>
+bool LevelData::loadCached(const std::string& filename)
+{
+	MappedFile file;
+	if (!file.open(filename))
+		return false;
+
+	const auto sourceHash = computeHash(file.getData(), file.getSize());
+	const auto cacheFilename = getCacheFilename(filename);
+
+	if (this->loadCompiled(cacheFilename, true, sourceHash))
+	// Compiled level is up to date.
+		return true;
+
+	if (!this->parseText(file.getData(), file.getSize()))
+		return false;
+
+	// Failed cache write is not an error (the level is loaded, the old cache is left untouched).
+	this->saveCompiled(cacheFilename, sourceHash);
+
+	return true;
+}
+
+/// <summary>
+/// Saves the level in the compiled (binary) format (see `CompiledLevelHeader`).
+/// The level is written to the temporary file which then atomically replaces the old file,
+/// so other processes reading (mapping) the old file are not affected and no half-written file is left.
+/// </summary>
+/// <param name="filename">Filename of the compiled level.</param>
+/// <param name="sourceHash">Hash of the source text level.</param>
+/// <returns>Returns `true` if saving was succesfull, else `false` (the old file is kept).</returns>
+bool LevelData::saveCompiled(const std::string& filename, std::uint64_t sourceHash) const
+{
+	const std::string temporaryFilename = getTemporaryFilename(filename);
+	if (!this->writeCompiled(temporaryFilename, sourceHash) || !replaceFile(temporaryFilename, filename))
+	{
+		std::remove(temporaryFilename.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Computes 64-bit hash of the data (FNV-1a variant processing 8 bytes at once).
+/// </summary>
+/// <param name="data">Data to hash.</param>
+/// <param name="size">Size of the data (in bytes).</param>
+/// <returns>Returns hash of the data.</returns>
+std::uint64_t LevelData::computeHash(const char* data, std::size_t size)
+{
+	const std::uint64_t prime = 1099511628211ULL;
+	std::uint64_t hash = 14695981039346656037ULL ^ size;
+
+	std::size_t i = 0;
+	for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+	{
+		std::uint64_t word;
+		std::memcpy(&word, data + i, sizeof(word));
+		hash = (hash ^ word) * prime;
+		hash ^= hash >> 29;
+	}
+	for (; i < size; i++)
+	{
+		hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+	}
+
+	return hash;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="filename">Filename of the text level.</param>
+/// <returns>Returns filename of the compiled level in the cache.</returns>
+std::string LevelData::getCacheFilename(const std::string& filename)
+{
+	return filename + compiledExtension_;
+}
+
+/// <summary>
+/// </summary>
+/// <param name="filename">Filename of the level.</param>
+/// <returns>Returns `true` if the file is compiled level (by its extension), else `false`.</returns>
+bool LevelData::isCompiledFilename(const std::string& filename)
+{
+	const std::string extension = compiledExtension_;
+	return filename.size() >= extension.size() &&
+		filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Removes all the level content.
+/// </summary>
+void LevelData::clear()
+{
+	this->tiles_.reset(0, 0);
+	this->hasPlayer_ = false;
+	this->playerStart_ = CellPosition();
+	this->enemySpawns_.clear();
+	this->solidRects_.clear();
+	this->finishRects_.clear();
+	this->coinCells_.clear();
+}
+
+/// <summary>
+/// Reads the first line of the map (`width height`) and skips white spaces behind it.
+/// </summary>
+/// <param name="actPos">Position where to start reading (moved behind the header).</param>
+/// <param name="end">End of the map data.</param>
+/// <param name="width">Read width of the map.</param>
+/// <param name="height">Read height of the map.</param>
+/// <returns>Returns `true` if reading was succesful, else `false`.</returns>
+bool LevelData::readMapHeader(const char*& actPos, const char* end, int& width, int& height)
+{
+	if (!this->readNumber(actPos, end, width) ||
+		!this->readNumber(actPos, end, height))
+		return false;
+
+	// Skip the white spaces before the map.
+	while (actPos != end && std::isspace(static_cast<unsigned char>(*actPos)))
+		actPos++;
+
+	return true;
+}
+
+/// <summary>
+/// Reads map reprezentaion from given data and stores all neccesary info about it.
+/// Rows are found serially, then they are split into blocks parsed in parallel
+/// (large maps only) and the results of the blocks are merged in the row order
+/// (the order of the spawns and coins does not depend on the number of threads).
+/// </summary>
+/// <param name="actPos">Position of the first map row in the data.</param>
+/// <param name="end">End of the map data.</param>
+/// <returns>Returns `true` if reading was succesful, else `false`.</returns>
+bool LevelData::readMapRepresentation(const char* actPos, const char* end)
+{
+	const int width = this->tiles_.getWidth();
+	const int height = this->tiles_.getHeight();
+
+	// Find the beginning of each row.
+	std::vector<const char*> rows(static_cast<std::size_t>(height));
+	for (int i = 0; i < height; i++)
+	{
+		// Missing row -> error
+		if (actPos == end) return false;
+
+		// Find the end of the actual row (`\r\n` line endings are accepted too).
+		const char* lineEnd = static_cast<const char*>(std::memchr(actPos, '\n', end - actPos));
+		if (lineEnd == nullptr)
+			lineEnd = end;
+		const char* nextLine = (lineEnd == end) ? end : lineEnd + 1;
+		if (lineEnd != actPos && *(lineEnd - 1) == '\r')
+			lineEnd--;
+
+		// Bad inputs -> error
+		if (lineEnd - actPos < width) return false;
+
+		rows[i] = actPos;
+		actPos = nextLine;
+	}
+
+	// Split the rows into blocks (one per thread).
+	std::size_t blockCount = 1;
+	if (this->tiles_.getSize() >= parallelCellLimit_)
+		blockCount = std::max(1u, std::thread::hardware_concurrency());
+	blockCount = std::min(blockCount, static_cast<std::size_t>(height));
+
+	std::vector<ParsedBlock> blocks(blockCount);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < blockCount; i++)
+	{
+		blocks[i].firstRow = static_cast<int>(height * i / blockCount);
+		blocks[i].lastRow = static_cast<int>(height * (i + 1) / blockCount);
+
+		// The last block is parsed by this thread.
+		if (i + 1 < blockCount)
+			threads.emplace_back(&LevelData::readRows, this, std::cref(rows), std::ref(blocks[i]));
+	}
+	this->readRows(rows, blocks.back());
+	for (auto&& thread : threads)
+		thread.join();
+
+	// Merge the blocks (in the row order).
+	for (auto&& block : blocks)
+	{
+		if (!block.valid)
+			return false;
+
+		if (block.hasPlayer)
+		// The last player in the map is used.
+		{
+			this->hasPlayer_ = true;
+			this->playerStart_ = block.playerStart;
+		}
+		this->enemySpawns_.insert(this->enemySpawns_.end(), block.enemySpawns.begin(), block.enemySpawns.end());
+		this->coinCells_.insert(this->coinCells_.end(), block.coinCells.begin(), block.coinCells.end());
+	}
+
+	this->mergeRectangles();
+	return true;
+}
+
+/// <summary>
+/// Parses rows of one block: stores the tile flags directly to the grid
+/// and collects the spawns and coins of the block (each block uses only its own rows).
+/// With SSE2 16 symbols are classified at once, the rest of the row is parsed per symbol.
+/// </summary>
+/// <param name="rows">Beginnings of all the rows of the map.</param>
+/// <param name="block">Block to parse (`firstRow` and `lastRow` set), results are stored in it.</param>
+void LevelData::readRows(const std::vector<const char*>& rows, ParsedBlock& block)
+{
+	const int width = this->tiles_.getWidth();
+
+	for (int i = block.firstRow; i < block.lastRow; i++)
+	// Read rows
+	{
+		const char* line = rows[i];
+		std::uint8_t* tiles = this->tiles_.getData() + this->tiles_.getIndex(i, 0);
+		int j = 0;
+
+#ifdef LEVELDATA_SSE2
+		const __m128i obstacleFlag = _mm_set1_epi8(TILE_OBSTACLE);
+		const __m128i coinFlag = _mm_set1_epi8(TILE_COIN);
+		const __m128i finishFlag = _mm_set1_epi8(TILE_FINISH);
+
+		for (; j + 16 <= width; j += 16)
+		// Classify 16 symbols at once.
+		{
+			const __m128i symbols = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + j));
+			const __m128i empty = _mm_cmpeq_epi8(symbols, _mm_set1_epi8(emptyCell_));
+			const __m128i obstacle = _mm_cmpeq_epi8(symbols, _mm_set1_epi8(obstacleCell_));
+			const __m128i player = _mm_cmpeq_epi8(symbols, _mm_set1_epi8(playerCell_));
+			const __m128i enemy = _mm_cmpeq_epi8(symbols, _mm_set1_epi8(enemyCell_));
+			const __m128i coin = _mm_cmpeq_epi8(symbols, _mm_set1_epi8(coinCell_));
+			const __m128i finish = _mm_cmpeq_epi8(symbols, _mm_set1_epi8(finishCell_));
+
+			const __m128i entities = _mm_or_si128(_mm_or_si128(player, enemy), coin);
+			const __m128i known = _mm_or_si128(_mm_or_si128(empty, obstacle), _mm_or_si128(entities, finish));
+
+			// Symbol not known.
+			if (_mm_movemask_epi8(known) != 0xFFFF)
+			{
+				block.valid = false;
+				return;
+			}
+
+			const __m128i flags = _mm_or_si128(_mm_and_si128(obstacle, obstacleFlag),
+									_mm_or_si128(_mm_and_si128(coin, coinFlag), _mm_and_si128(finish, finishFlag)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(tiles + j), flags);
+
+			// Store the entities (rare symbols, one by one).
+			for (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(entities)); mask != 0; mask &= mask - 1)
+			{
+				const int column = j + findLowestBit(mask);
+				this->readCell(line[column], i, column, tiles[column], block);
+			}
+		}
+#endif
+
+		for (; j < width; j++)
+		// Check each collumn in row.
+		{
+			if (!this->readCell(line[j], i, j, tiles[j], block))
+			// Symbol not known.
+			{
+				block.valid = false;
+				return;
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Stores the content of one map cell.
+/// </summary>
+/// <param name="symbol">Symbol of the cell.</param>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <param name="tile">Flags of the cell in the grid.</param>
+/// <param name="block">Parsed block containing the cell.</param>
+/// <returns>Returns `true` if the symbol is known, else `false`.</returns>
+bool LevelData::readCell(char symbol, int row, int column, std::uint8_t& tile, ParsedBlock& block) const
+{
+	switch (symbol)
+	{
+	case emptyCell_:
+		break;
+
+	case obstacleCell_:
+	// Obstacle -> mark the cell (merged after the whole map is read)
+		tile = TILE_OBSTACLE;
+		break;
+
+	case playerCell_:
+	// Player -> set start position of the player
+		block.hasPlayer = true;
+		block.playerStart = { row, column };
+		break;
+
+	case enemyCell_:
+	// Enemy -> add to spawn table
+		block.enemySpawns.push_back({ row, column });
+		break;
+
+	case coinCell_:
+	// Coin -> store the cell
+		tile = TILE_COIN;
+		block.coinCells.push_back(this->tiles_.getIndex(row, column));
+		break;
+
+	case finishCell_:
+	// Finish -> mark the cell (merged after the whole map is read)
+		tile = TILE_FINISH;
+		break;
+
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Reads decimal integer (with optional sign) preceded by white spaces.
+/// </summary>
+/// <param name="actPos">Position where to start reading (moved behind the number).</param>
+/// <param name="end">End of the data.</param>
+/// <param name="number">Read number.</param>
+/// <returns>Returns `true` if number was read, else `false` (missing or too big number).</returns>
+bool LevelData::readNumber(const char*& actPos, const char* end, int& number)
+{
+	while (actPos != end && std::isspace(static_cast<unsigned char>(*actPos)))
+		actPos++;
+
+	bool negative = false;
+	if (actPos != end && (*actPos == '-' || *actPos == '+'))
+	{
+		negative = (*actPos == '-');
+		actPos++;
+	}
+
+	// At least one digit required.
+	if (actPos == end || !std::isdigit(static_cast<unsigned char>(*actPos)))
+		return false;
+
+	long long value = 0;
+	while (actPos != end && std::isdigit(static_cast<unsigned char>(*actPos)))
+	{
+		value = value * 10 + (*actPos - '0');
+		if (value > std::numeric_limits<int>::max())
+		// Number does not fit to `int`.
+			return false;
+		actPos++;
+	}
+
+	number = static_cast<int>(negative ? -value : value);
+	return true;
+}
+
+/// <summary>
+/// Merges adjacent obstacle and finish cells of the whole map into large rectangles
+/// (window objects are created per rectangle instead of per cell).
+/// </summary>
+void LevelData::mergeRectangles()
+{
+	const int width = this->tiles_.getWidth();
+	const int height = this->tiles_.getHeight();
+
+	this->solidRects_ = this->tiles_.mergeRectangles(TILE_OBSTACLE, 0, 0, height, width);
+	this->finishRects_ = this->tiles_.mergeRectangles(TILE_FINISH, 0, 0, height, width);
+}
+
+/// <summary>
+/// Writes the level in the compiled format to the new file.
+/// </summary>
+/// <param name="filename">Filename of the written file.</param>
+/// <param name="sourceHash">Hash of the source text level.</param>
+/// <returns>Returns `true` if writing was succesfull, else `false`.</returns>
+bool LevelData::writeCompiled(const std::string& filename, std::uint64_t sourceHash) const
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	// Header:
+	CompiledLevelHeader header;
+	std::memcpy(header.magic, "PLVL", 4);
+	header.version = compiledVersion_;
+	header.sourceHash = sourceHash;
+	header.width = this->tiles_.getWidth();
+	header.height = this->tiles_.getHeight();
+	header.playerRow = this->hasPlayer_ ? this->playerStart_.row : -1;
+	header.playerColumn = this->hasPlayer_ ? this->playerStart_.column : -1;
+	header.enemyCount = this->enemySpawns_.size();
+	header.solidRectCount = this->solidRects_.size();
+	header.finishRectCount = this->finishRects_.size();
+	header.coinCount = this->coinCells_.size();
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// Tile grid:
+	file.write(reinterpret_cast<const char*>(this->tiles_.getData()), this->tiles_.getSize());
+
+	// Spawn table:
+	for (auto&& enemy : this->enemySpawns_)
+	{
+		const std::int32_t position[2] = { enemy.row, enemy.column };
+		file.write(reinterpret_cast<const char*>(position), sizeof(position));
+	}
+
+	// Merged rectangles:
+	file.write(reinterpret_cast<const char*>(this->solidRects_.data()), this->solidRects_.size() * sizeof(TileRect));
+	file.write(reinterpret_cast<const char*>(this->finishRects_.data()), this->finishRects_.size() * sizeof(TileRect));
+
+	// Coin table:
+	file.write(reinterpret_cast<const char*>(this->coinCells_.data()), this->coinCells_.size() * sizeof(std::uint64_t));
+
+	// Closed before the file is moved.
+	file.close();
+	return !file.fail();
+}
+
+/// <summary>
+/// Reads table of the merged rectangles from the compiled level
+/// and checks that all of them lie inside the map.
+/// </summary>
+/// <param name="actPos">Position of the table (moved behind it).</param>
+/// <param name="count">Number of the rectangles in the table.</param>
+/// <param name="rectangles">Read rectangles.</param>
+/// <returns>Returns `true` if all the rectangles are valid, else `false`.</returns>
+bool LevelData::readRectangles(const char*& actPos, std::uint64_t count, std::vector<TileRect>& rectangles)
+{
+	rectangles.resize(static_cast<std::size_t>(count));
+	if (count > 0)
+		std::memcpy(rectangles.data(), actPos, rectangles.size() * sizeof(TileRect));
+	actPos += count * sizeof(TileRect);
+
+	for (auto&& rectangle : rectangles)
+	{
+		if (rectangle.rows <= 0 || rectangle.columns <= 0 ||
+			!this->tiles_.isInside(rectangle.row, rectangle.column) ||
+			rectangle.rows > this->tiles_.getHeight() - rectangle.row ||
+			rectangle.columns > this->tiles_.getWidth() - rectangle.column)
+			return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,120 @@
+#ifndef LEVELDATA_H_
+#define LEVELDATA_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "TileGrid.h"
+#include "MappedFile.h"
+
+// Relative position of one map cell.
+struct CellPosition
+{
+	int row = 0;
+	int column = 0;
+};
+
+// Header of the compiled (binary) level file.
+// Followed by:	tile grid (`width * height` bytes),
+//				enemy spawn table (`enemyCount` x { int32 row, int32 column }),
+//				merged obstacle rectangles (`solidRectCount` x `TileRect`),
+//				merged finish rectangles (`finishRectCount` x `TileRect`),
+//				coin cell indices (`coinCount` x `uint64`).
+struct CompiledLevelHeader
+{
+	char magic[4];
+	std::uint32_t version;
+	std::uint64_t sourceHash;
+	std::int32_t width;
+	std::int32_t height;
+	// Player start cell (`-1` if the map contains no player).
+	std::int32_t playerRow;
+	std::int32_t playerColumn;
+	std::uint64_t enemyCount;
+	std::uint64_t solidRectCount;
+	std::uint64_t finishRectCount;
+	std::uint64_t coinCount;
+};
+
+// Parsed level (independent of the window objects),
+// can be read from the text format or from the compiled format.
+class LevelData
+{
+public:
+	// Static content of each cell.
+	TileGrid tiles_;
+
+	// Spawn table:
+	bool hasPlayer_ = false;
+	CellPosition playerStart_;
+	std::vector<CellPosition> enemySpawns_;
+
+	// Precomputed static objects (row-major order),
+	// adjacent obstacle and finish cells are merged into large rectangles:
+	std::vector<TileRect> solidRects_;
+	std::vector<TileRect> finishRects_;
+	std::vector<std::uint64_t> coinCells_;
+
+	// Loading functions:
+	bool load(const std::string& filename);
+	bool loadText(const std::string& filename);
+	bool parseText(const char* data, std::size_t size);
+	bool loadCompiled(const std::string& filename, bool checkHash, std::uint64_t sourceHash);
+	bool loadCached(const std::string& filename);
+
+	// Saving function:
+	bool saveCompiled(const std::string& filename, std::uint64_t sourceHash) const;
+
+	// Helper functions for the compiled levels cache:
+	static std::uint64_t computeHash(const char* data, std::size_t size);
+	static std::string getCacheFilename(const std::string& filename);
+	static bool isCompiledFilename(const std::string& filename);
+
+private:
+	// Static symbols for map reprezentation:
+	static const char emptyCell_ = '.';
+	static const char obstacleCell_ = '#';
+	static const char playerCell_ = 'P';
+	static const char enemyCell_ = 'E';
+	static const char coinCell_ = 'C';
+	static const char finishCell_ = 'F';
+
+	// Version of the compiled format (increase on every format change).
+	static const std::uint32_t compiledVersion_ = 2;
+
+	// Extension of the compiled level files.
+	static const char* const compiledExtension_;
+
+	// Maps with at least this number of cells are parsed by multiple threads.
+	static const std::size_t parallelCellLimit_ = 1 << 20;
+
+	// Result of parsing one block of the rows (`firstRow` to `lastRow - 1`).
+	struct ParsedBlock
+	{
+		int firstRow = 0;
+		int lastRow = 0;
+
+		bool valid = true;
+		bool hasPlayer = false;
+		CellPosition playerStart;
+		std::vector<CellPosition> enemySpawns;
+		std::vector<std::uint64_t> coinCells;
+	};
+
+	void clear();
+
+	// Text parsing functions:
+	bool readMapHeader(const char*& actPos, const char* end, int& width, int& height);
+	bool readMapRepresentation(const char* actPos, const char* end);
+	void readRows(const std::vector<const char*>& rows, ParsedBlock& block);
+	bool readCell(char symbol, int row, int column, std::uint8_t& tile, ParsedBlock& block) const;
+	bool readNumber(const char*& actPos, const char* end, int& number);
+	void mergeRectangles();
+
+	// Compiled format helpers:
+	bool readRectangles(const char*& actPos, std::uint64_t count, std::vector<TileRect>& rectangles);
+	bool writeCompiled(const std::string& filename, std::uint64_t sourceHash) const;
+};
+
+#endif
@@ -18,78 +18,6 @@ void LivingObject::initRelativePos(int row, int column)
 	this->bottomBorderRel_ = column;
 }
 
-/// <summary>
-/// Moves the object to left by given offset (`speed`), 
-/// additionaly sometimes changes relative coordinates.
-/// </summary>
-/// <param name="speed">How much to move.</param>
-/// <param name="changeRel">Should the relative coordinates change (yes - `true`, no - `false`).</param>
-void LivingObject::moveLeft(float speed, bool changeRel)
-{
-	if (changeRel)
-	// Relative coordinates change.
-	{
-		this->leftBorderRel_--;
-		this->rightBorderRel_--;
-	}
-
-	this->absObject_.move({ -speed, 0 });
-}
-
-/// <summary>
-/// Moves the object to right by given offset (`speed`), 
-/// additionaly sometimes changes relative coordinates.
-/// </summary>
-/// <param name="speed">How much to move.</param>
-/// <param name="changeRel">Should the relative coordinates change (yes - `true`, no - `false`).</param>
-void LivingObject::moveRight(float speed, bool changeRel)
-{
-	if (changeRel)
-	// Relative coordinates change.
-	{
-		this->leftBorderRel_++;
-		this->rightBorderRel_++;
-	}
-
-	this->absObject_.move({ speed, 0 });
-}
-
-/// <summary>
-/// Moves the object up by given offset (`speed`), 
-/// additionaly sometimes changes relative coordinates.
-/// </summary>
-/// <param name="speed">How much to move.</param>
-/// <param name="changeRel">Should the relative coordinates change (yes - `true`, no - `false`).</param>
-void LivingObject::jump(float speed, bool changeRel)
-{
-	if (changeRel)
-	// Relative coordinates change.
-	{
-		this->topBorderRel_--;
-		this->bottomBorderRel_--;
-	}
-
-	this->absObject_.move({ 0, -speed });
-}
-
-/// <summary>
-/// Moves the object down by given offset (`speed`), 
-/// additionaly sometimes changes relative coordinates.
-/// </summary>
-/// <param name="speed">How much to move.</param>
-/// <param name="changeRel">Should the relative coordinates change (yes - `true`, no - `false`).</param>
-void LivingObject::fall(float speed, bool changeRel)
-{
-	if (changeRel)
-	// Relative coordinates change.
-	{
-		this->topBorderRel_++;
-		this->bottomBorderRel_++;
-	}
-
-	this->absObject_.move({ 0, speed });
-}
-
 /// <summary>
 /// Checks whether window objects of the given object and `this` object collides.
 /// </summary>
@@ -102,4 +30,14 @@ bool LivingObject::isCollidingWithObject(const AbstractObject& object)
 		return true;
 
 	return false;
+}
+
+/// <summary>
+/// Checks whether window object of `this` object collides with the bounding box.
+/// </summary>
+/// <param name="bounds">Bounding box to check collision (absolute coordinates).</param>
+/// <returns>Returns `true` if object collides with the box (intesects), else `false`.</returns>
+bool LivingObject::isCollidingWithObject(const sf::FloatRect& bounds)
+{
+	return this->absObject_.winObject_.getGlobalBounds().intersects(bounds);
 }
\ No newline at end of file
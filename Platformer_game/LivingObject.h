@@ -21,14 +21,9 @@ public:
 	LivingObject();
 	void initRelativePos(int row, int column);
 
-	// Moving object functions:
-	void moveLeft(float speed, bool changeRel);
-	void moveRight(float speed, bool changeRel);
-	void jump(float speed, bool changeRel);
-	void fall(float speed, bool changeRel);
-
 	// Checking collistion:
 	bool isCollidingWithObject(const AbstractObject& object);
+	bool isCollidingWithObject(const sf::FloatRect& bounds);
 };
 
 
@@ -0,0 +1,145 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+MappedFile::MappedFile() {}
+
+MappedFile::~MappedFile()
+{
+	this->close();
+}
+
+/// <summary>
+/// Maps the whole file to the memory (read only). Previously opened file is closed.
+/// </summary>
+/// <param name="filename">Name of the file to map.</param>
+/// <returns>Returns `true` if mapping was succesfull, else `false` (also for empty file).</returns>
+bool MappedFile::open(const std::string& filename)
+{
+	this->close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+							OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	this->fileHandle_ = file;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 ||
+		static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<std::size_t>(-1))
+	// Empty file or file too big for the address space.
+	{
+		this->close();
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		this->close();
+		return false;
+	}
+	this->mappingHandle_ = mapping;
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL)
+	{
+		this->close();
+		return false;
+	}
+
+	this->data_ = static_cast<const char*>(view);
+	this->size_ = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+	this->fileDescriptor_ = ::open(filename.c_str(), O_RDONLY);
+	if (this->fileDescriptor_ < 0)
+		return false;
+
+	struct stat fileInfo;
+	if (fstat(this->fileDescriptor_, &fileInfo) != 0 || fileInfo.st_size <= 0)
+	// Empty file (cannot be mapped).
+	{
+		this->close();
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<std::size_t>(fileInfo.st_size), PROT_READ,
+					MAP_PRIVATE, this->fileDescriptor_, 0);
+	if (view == MAP_FAILED)
+	{
+		this->close();
+		return false;
+	}
+
+	// The file is read from the beginning to the end.
+	madvise(view, static_cast<std::size_t>(fileInfo.st_size), MADV_SEQUENTIAL);
+
+	this->data_ = static_cast<const char*>(view);
+	this->size_ = static_cast<std::size_t>(fileInfo.st_size);
+#endif
+
+	return true;
+}
+
+/// <summary>
+/// Unmaps the file and releases all the handles.
+/// </summary>
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (this->data_ != nullptr)
+		UnmapViewOfFile(this->data_);
+	if (this->mappingHandle_ != nullptr)
+		CloseHandle(this->mappingHandle_);
+	if (this->fileHandle_ != nullptr)
+		CloseHandle(this->fileHandle_);
+
+	this->mappingHandle_ = nullptr;
+	this->fileHandle_ = nullptr;
+#else
+	if (this->data_ != nullptr)
+		munmap(const_cast<char*>(this->data_), this->size_);
+	if (this->fileDescriptor_ >= 0)
+		::close(this->fileDescriptor_);
+
+	this->fileDescriptor_ = -1;
+#endif
+
+	this->data_ = nullptr;
+	this->size_ = 0;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns `true` if some file is mapped, else `false`.</returns>
+bool MappedFile::isOpen() const
+{
+	return this->data_ != nullptr;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns pointer to the first byte of the mapped file.</returns>
+const char* MappedFile::getData() const
+{
+	return this->data_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns size of the mapped file (in bytes).</returns>
+std::size_t MappedFile::getSize() const
+{
+	return this->size_;
+}
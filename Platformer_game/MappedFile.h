@@ -0,0 +1,40 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of the whole file (the bytes are not copied).
+class MappedFile
+{
+public:
+	// Initial and setup functions:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool open(const std::string& filename);
+	void close();
+
+	// Functions to obtain the mapped content:
+	bool isOpen() const;
+	const char* getData() const;
+	std::size_t getSize() const;
+
+private:
+	// Mapped content of the file.
+	const char* data_ = nullptr;
+	std::size_t size_ = 0;
+
+	// Operating system handles of the mapping:
+#ifdef _WIN32
+	void* fileHandle_ = nullptr;
+	void* mappingHandle_ = nullptr;
+#else
+	int fileDescriptor_ = -1;
+#endif
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "NullRenderBackend.h"
+
+// Public functions:
+
+/// <summary>
+/// Only remembers the window size (no window is created).
+/// </summary>
+/// <param name="videoMode">Size of the pretended window.</param>
+/// <param name="title">Not used.</param>
+/// <param name="fontFilename">Not used (no font is loaded).</param>
+void NullRenderBackend::open(const sf::VideoMode& videoMode, const std::string& /*title*/,
+	const std::string& /*fontFilename*/)
+{
+	this->size_ = sf::Vector2u(videoMode.width, videoMode.height);
+	this->open_ = true;
+}
+
+/// <summary>
+/// Marks the pretended window as closed.
+/// </summary>
+void NullRenderBackend::close()
+{
+	this->open_ = false;
+}
+
+/// <summary>
+/// Checks whether the pretended window is still open.
+/// </summary>
+/// <returns>Returns `true` if not closed yet, else `false`.</returns>
+bool NullRenderBackend::isOpen() const
+{
+	return this->open_;
+}
+
+/// <summary>
+/// Gets size of the pretended window.
+/// </summary>
+/// <returns>Returns size given at the opening.</returns>
+sf::Vector2u NullRenderBackend::getSize() const
+{
+	return this->size_;
+}
+
+/// <summary>
+/// Skips the font loading (texts are never drawn).
+/// </summary>
+/// <returns>Returns always `true`.</returns>
+bool NullRenderBackend::loadFont(sf::Font& /*font*/, const std::string& /*fontFilename*/)
+{
+	return true;
+}
+
+/// <summary>
+/// There are no window events.
+/// </summary>
+/// <returns>Returns always `false`.</returns>
+bool NullRenderBackend::pollEvent(sf::Event& /*event*/)
+{
+	return false;
+}
+
+/// <summary>
+/// There is no keyboard.
+/// </summary>
+/// <returns>Returns always `false`.</returns>
+bool NullRenderBackend::isKeyPressed(sf::Keyboard::Key /*key*/)
+{
+	return false;
+}
+
+/// <summary>
+/// There is no mouse.
+/// </summary>
+/// <returns>Returns position outside of the view.</returns>
+sf::Vector2f NullRenderBackend::getMousePosition(const sf::View& /*view*/)
+{
+	return sf::Vector2f(-1.0f, -1.0f);
+}
+
+/// <summary>
+/// Nothing is drawn (the game does not need to prepare frames).
+/// </summary>
+/// <returns>Returns always `false`.</returns>
+bool NullRenderBackend::isDrawing() const
+{
+	return false;
+}
+
+/// <summary>
+/// Gets the snapshot of the next frame (the same one each frame).
+/// </summary>
+/// <returns>Returns empty snapshot.</returns>
+RenderSnapshot& NullRenderBackend::beginFrame()
+{
+	this->snapshot_.clear();
+	return this->snapshot_;
+}
+
+/// <summary>
+/// Discards the frame.
+/// </summary>
+void NullRenderBackend::publishFrame()
+{
+}
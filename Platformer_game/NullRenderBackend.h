@@ -0,0 +1,44 @@
+#ifndef NULLRENDERBACKEND_H_
+#define NULLRENDERBACKEND_H_
+
+#include <string>
+
+#include "SFML_includes.h"
+#include "RenderBackend.h"
+
+// Render backend without any window (headless runs, no display needed).
+// No window is created, no font is loaded, frames are discarded and there is no input.
+class NullRenderBackend : public RenderBackend
+{
+public:
+	NullRenderBackend() = default;
+
+	// Window functions:
+	void open(const sf::VideoMode& videoMode, const std::string& title,
+		const std::string& fontFilename) override;
+	void close() override;
+	bool isOpen() const override;
+	sf::Vector2u getSize() const override;
+
+	bool loadFont(sf::Font& font, const std::string& fontFilename) override;
+
+	// Input functions:
+	bool pollEvent(sf::Event& event) override;
+	bool isKeyPressed(sf::Keyboard::Key key) override;
+	sf::Vector2f getMousePosition(const sf::View& view) override;
+
+	// Frame functions:
+	bool isDrawing() const override;
+	RenderSnapshot& beginFrame() override;
+	void publishFrame() override;
+
+private:
+	bool open_ = false;
+	// Pretended window size (the game view depends on it).
+	sf::Vector2u size_;
+
+	// Snapshot filled by the game (never drawn).
+	RenderSnapshot snapshot_;
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef PLAYERINPUT_H_
+#define PLAYERINPUT_H_
+
+#include <cstdint>
+
+// Pressed keys of the player in one simulation tick (bit mask).
+enum InputKey : std::uint8_t
+{
+	INPUT_NONE = 0,
+	INPUT_LEFT = 1 << 0,
+	INPUT_RIGHT = 1 << 1,
+	INPUT_UP = 1 << 2
+};
+
+#endif
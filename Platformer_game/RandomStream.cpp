@@ -0,0 +1,97 @@
+#include "RandomStream.h"
+
+/// <summary>
+/// Creates generator with zero seed (first stream).
+/// </summary>
+RandomStream::RandomStream()
+{
+	this->seed(0, 0);
+}
+
+/// <summary>
+/// Creates seeded generator.
+/// </summary>
+/// <param name="seed">Seed of the sequence.</param>
+/// <param name="stream">Index of the independent stream.</param>
+RandomStream::RandomStream(std::uint64_t seed, std::uint64_t stream)
+{
+	this->seed(seed, stream);
+}
+
+/// <summary>
+/// Restarts the generator (PCG32 initialization).
+/// </summary>
+/// <param name="seed">Seed of the sequence.</param>
+/// <param name="stream">Index of the independent stream.</param>
+void RandomStream::seed(std::uint64_t seed, std::uint64_t stream)
+{
+	this->state_ = 0;
+	this->increment_ = (stream << 1) | 1;
+	this->next();
+	this->state_ += seed;
+	this->next();
+}
+
+/// <summary>
+/// Generates next number of the sequence (PCG XSH RR variant).
+/// </summary>
+/// <returns>Returns uniformly distributed 32-bit number.</returns>
+std::uint32_t RandomStream::next()
+{
+	std::uint64_t oldState = this->state_;
+	this->state_ = oldState * 6364136223846793005ULL + this->increment_;
+
+	std::uint32_t xorShifted = static_cast<std::uint32_t>(((oldState >> 18) ^ oldState) >> 27);
+	std::uint32_t rotation = static_cast<std::uint32_t>(oldState >> 59);
+	return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+/// <summary>
+/// Generates number from the interval [0, bound) without the modulo bias
+/// (multiplication method, biased low parts are rejected).
+/// </summary>
+/// <param name="bound">Upper bound (exclusive, greater than 0).</param>
+/// <returns>Returns uniformly distributed number smaller than `bound`.</returns>
+std::uint32_t RandomStream::nextBelow(std::uint32_t bound)
+{
+	std::uint64_t product = static_cast<std::uint64_t>(this->next()) * bound;
+	std::uint32_t low = static_cast<std::uint32_t>(product);
+	if (low < bound)
+	{
+		std::uint32_t threshold = (0u - bound) % bound;
+		while (low < threshold)
+		{
+			product = static_cast<std::uint64_t>(this->next()) * bound;
+			low = static_cast<std::uint32_t>(product);
+		}
+	}
+
+	return static_cast<std::uint32_t>(product >> 32);
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns uniformly distributed number from the interval [0, 1).</returns>
+float RandomStream::nextFloat()
+{
+	// 24 bits -> all values are exactly representable.
+	return static_cast<float>(this->next() >> 8) * (1.0f / 16777216.0f);
+}
+
+/// <summary>
+/// </summary>
+/// <param name="min">Lower bound (inclusive).</param>
+/// <param name="max">Upper bound (exclusive).</param>
+/// <returns>Returns uniformly distributed number from the interval [min, max).</returns>
+float RandomStream::nextFloat(float min, float max)
+{
+	return min + (max - min) * this->nextFloat();
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns `true` or `false` with the same probability.</returns>
+bool RandomStream::nextBool()
+{
+	return (this->next() >> 31) != 0;
+}
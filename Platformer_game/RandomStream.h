@@ -0,0 +1,41 @@
+#ifndef RANDOMSTREAM_H_
+#define RANDOMSTREAM_H_
+
+#include <cstdint>
+
+// Independent random streams of the game (each subsystem has its own one,
+// so changes in one subsystem do not change random numbers of the others).
+enum RandomSubsystem : std::uint64_t
+{
+	RANDOM_ENEMY_DIRECTION = 1,
+	RANDOM_ENEMY_STRIKE = 2,
+	RANDOM_BULLET_SPEED = 3,
+	RANDOM_INPUT = 4
+};
+
+// Fast seeded random number generator (PCG32) with independent streams.
+// Same seed and stream always give the same sequence (reproducible runs),
+// there is no hidden global state (unlike `rand()`).
+class RandomStream
+{
+public:
+	// Initial and setup functions:
+	RandomStream();
+	RandomStream(std::uint64_t seed, std::uint64_t stream);
+
+	void seed(std::uint64_t seed, std::uint64_t stream);
+
+	// Generating functions:
+	std::uint32_t next();
+	std::uint32_t nextBelow(std::uint32_t bound);
+	float nextFloat();
+	float nextFloat(float min, float max);
+	bool nextBool();
+
+private:
+	std::uint64_t state_ = 0;
+	// Selects the stream (always odd).
+	std::uint64_t increment_ = 1;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef RENDERBACKEND_H_
+#define RENDERBACKEND_H_
+
+#include <string>
+
+#include "SFML_includes.h"
+#include "RenderSnapshot.h"
+
+// Everything the game needs from the window (creation, events, input and frame output).
+// The game logic works only with this interface, so it runs unchanged with or without
+// the real window (`SfmlRenderBackend` or `NullRenderBackend`).
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	// Window functions:
+	virtual void open(const sf::VideoMode& videoMode, const std::string& title,
+		const std::string& fontFilename) = 0;
+	virtual void close() = 0;
+	virtual bool isOpen() const = 0;
+	virtual sf::Vector2u getSize() const = 0;
+
+	// Game thread font (used only for the text layout).
+	virtual bool loadFont(sf::Font& font, const std::string& fontFilename) = 0;
+
+	// Input functions:
+	virtual bool pollEvent(sf::Event& event) = 0;
+	virtual bool isKeyPressed(sf::Keyboard::Key key) = 0;
+	virtual sf::Vector2f getMousePosition(const sf::View& view) = 0;
+
+	// Frame functions (frames are not prepared at all if nothing is drawn):
+	virtual bool isDrawing() const = 0;
+	virtual RenderSnapshot& beginFrame() = 0;
+	virtual void publishFrame() = 0;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#include "RenderSnapshot.h"
+
+/// <summary>
+/// Removes the content of the previous frame (memory is kept).
+/// </summary>
+void RenderSnapshot::clear()
+{
+	this->quads_.clear();
+	this->texts_.clear();
+	this->showHud_ = false;
+}
+
+/// <summary>
+/// Adds copy of the text parameters to the frame.
+/// </summary>
+/// <param name="text">Text to draw.</param>
+void RenderSnapshot::addText(const sf::Text& text)
+{
+	SnapshotText snapshotText;
+	snapshotText.string = text.getString();
+	snapshotText.position = text.getPosition();
+	snapshotText.origin = text.getOrigin();
+	snapshotText.characterSize = text.getCharacterSize();
+	snapshotText.color = text.getFillColor();
+	snapshotText.style = text.getStyle();
+
+	this->texts_.push_back(std::move(snapshotText));
+}
+
+/// <summary>
+/// Shows the HUD with the given values in the frame.
+/// </summary>
+/// <param name="points">Actual score.</param>
+/// <param name="lifes">Actual number of lifes.</param>
+void RenderSnapshot::setHud(int points, int lifes)
+{
+	this->showHud_ = true;
+	this->points_ = points;
+	this->lifes_ = lifes;
+}
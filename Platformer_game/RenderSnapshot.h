@@ -0,0 +1,45 @@
+#ifndef RENDERSNAPSHOT_H_
+#define RENDERSNAPSHOT_H_
+
+#include <string>
+#include <vector>
+
+#include "SFML_includes.h"
+#include "SpriteBatch.h"
+
+// Copy of the text parameters needed to draw it.
+struct SnapshotText
+{
+	sf::String string;
+	sf::Vector2f position;
+	sf::Vector2f origin;
+	unsigned characterSize = 30;
+	sf::Color color;
+	sf::Uint32 style = sf::Text::Regular;
+};
+
+// Everything needed to draw one frame (independent of the game objects,
+// so it can be drawn on the other thread while the game is updated).
+class RenderSnapshot
+{
+public:
+	// View used to draw the frame.
+	sf::View view_;
+
+	// Quads of all the objects (in the drawing order).
+	SpriteBatch quads_;
+
+	// Texts drawn over the quads (in the drawing order, screen coordinates).
+	std::vector<SnapshotText> texts_;
+
+	// Values displayed by the HUD (if shown).
+	bool showHud_ = false;
+	int points_ = 0;
+	int lifes_ = 0;
+
+	void clear();
+	void addText(const sf::Text& text);
+	void setHud(int points, int lifes);
+};
+
+#endif
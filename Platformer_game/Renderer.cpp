@@ -0,0 +1,147 @@
+#include "Renderer.h"
+
+#include <iostream>
+#include <chrono>
+
+
+Renderer::Renderer() {}
+
+/// <summary>
+/// Stops the render thread (if running).
+/// </summary>
+Renderer::~Renderer()
+{
+	this->stop();
+}
+
+/// <summary>
+/// Starts the render thread drawing on the window
+/// (the window must not be drawn to from the other threads until `stop`).
+/// </summary>
+/// <param name="window">Window where to draw.</param>
+/// <param name="fontFilename">Filename of the font of the texts.</param>
+void Renderer::start(sf::RenderWindow& window, const std::string& fontFilename)
+{
+	if (this->running_)
+		return;
+
+	if (!this->font_.loadFromFile(fontFilename))
+	// Font cann't be loaded.
+	{
+		std::cout << "Cann't read the font file." << std::endl;
+	}
+	this->hud_.init(this->font_, 24, sf::Color::White, true);
+
+	this->window_ = &window;
+
+	// The window context can be active only in one thread.
+	this->window_->setActive(false);
+	this->running_ = true;
+	this->thread_ = std::thread(&Renderer::run, this);
+}
+
+/// <summary>
+/// Stops the render thread and gives the window back to the calling thread.
+/// </summary>
+void Renderer::stop()
+{
+	if (!this->thread_.joinable())
+		return;
+
+	this->running_ = false;
+	this->thread_.join();
+	this->window_->setActive(true);
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns empty snapshot to be filled by the next frame.</returns>
+RenderSnapshot& Renderer::beginFrame()
+{
+	auto& snapshot = this->snapshots_.getWriteBuffer();
+	snapshot.clear();
+	return snapshot;
+}
+
+/// <summary>
+/// Passes the filled snapshot to the render thread (never waits).
+/// </summary>
+void Renderer::publishFrame()
+{
+	this->snapshots_.publish();
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns `true` if the render thread is running, else `false`.</returns>
+bool Renderer::isRunning()
+{
+	return this->running_;
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Main loop of the render thread (draws every newly published snapshot).
+/// </summary>
+void Renderer::run()
+{
+	this->window_->setActive(true);
+
+	while (this->running_)
+	{
+		if (!this->snapshots_.update())
+		// No new frame -> wait for a while.
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		this->drawSnapshot(this->snapshots_.getReadBuffer());
+	}
+
+	this->window_->setActive(false);
+}
+
+/// <summary>
+/// Draws the snapshot on the window and displays it.
+/// </summary>
+/// <param name="snapshot">Frame to draw.</param>
+void Renderer::drawSnapshot(const RenderSnapshot& snapshot)
+{
+	this->window_->clear();
+	this->window_->setView(snapshot.view_);
+
+	snapshot.quads_.drawTo(*this->window_);
+
+	// Texts in the screen space (objects are reused between the frames).
+	this->window_->setView(this->window_->getDefaultView());
+	if (this->texts_.size() < snapshot.texts_.size())
+		this->texts_.resize(snapshot.texts_.size(), sf::Text());
+
+	for (std::size_t i = 0; i < snapshot.texts_.size(); i++)
+	{
+		const auto& snapshotText = snapshot.texts_[i];
+		auto& text = this->texts_[i];
+
+		text.setFont(this->font_);
+		text.setString(snapshotText.string);
+		text.setCharacterSize(snapshotText.characterSize);
+		text.setFillColor(snapshotText.color);
+		text.setStyle(snapshotText.style);
+		text.setOrigin(snapshotText.origin);
+		text.setPosition(snapshotText.position);
+
+		this->window_->draw(text);
+	}
+
+	// HUD (laid out again only if the values changed).
+	if (snapshot.showHud_)
+	{
+		this->hud_.setValues(snapshot.points_, snapshot.lifes_);
+		this->hud_.drawTo(*this->window_);
+	}
+
+	this->window_->display();
+}
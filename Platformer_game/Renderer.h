@@ -0,0 +1,55 @@
+#ifndef RENDERER_H_
+#define RENDERER_H_
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "SFML_includes.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "Hud.h"
+
+// Draws the frames on the window on its own thread.
+// The game fills a snapshot and publishes it, the render thread draws the latest one
+// (the game can update the next frame while the previous one is drawn).
+class Renderer
+{
+public:
+	// Initial and setup functions:
+	Renderer();
+	~Renderer();
+
+	Renderer(const Renderer&) = delete;
+	Renderer& operator=(const Renderer&) = delete;
+
+	void start(sf::RenderWindow& window, const std::string& fontFilename);
+	void stop();
+
+	// Frame functions (game thread):
+	RenderSnapshot& beginFrame();
+	void publishFrame();
+
+	bool isRunning();
+
+private:
+	sf::RenderWindow* window_ = nullptr;
+
+	// Font of the render thread (the game thread uses its own one for text layout).
+	sf::Font font_;
+	std::vector<sf::Text> texts_;
+	Hud hud_;
+
+	// Snapshots exchanged between the threads.
+	TripleBuffer<RenderSnapshot> snapshots_;
+
+	// Render thread variables:
+	std::thread thread_;
+	std::atomic<bool> running_{ false };
+
+	void run();
+	void drawSnapshot(const RenderSnapshot& snapshot);
+};
+
+#endif
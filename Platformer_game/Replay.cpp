@@ -0,0 +1,180 @@
+#include "Replay.h"
+
+#include <fstream>
+#include <cstring>
+#include <limits>
+
+static_assert(sizeof(float) == 4, "Replay file stores 32-bit floats.");
+
+/// <summary>
+/// Removes all the recorded input (the setup is kept).
+/// </summary>
+void Replay::clear()
+{
+	this->runs_.clear();
+	this->tickCount_ = 0;
+	this->rewind();
+}
+
+/// <summary>
+/// Appends keys of the next tick.
+/// </summary>
+/// <param name="keys">Pressed keys (`InputKey` bit mask).</param>
+void Replay::record(std::uint8_t keys)
+{
+	if (this->runs_.empty() || this->runs_.back().keys != keys ||
+		this->runs_.back().ticks == std::numeric_limits<std::uint32_t>::max())
+	// Keys changed -> new run
+	{
+		InputRun run = {};
+		run.keys = keys;
+		this->runs_.push_back(run);
+	}
+
+	this->runs_.back().ticks++;
+	this->tickCount_++;
+}
+
+/// <summary>
+/// Moves the playback to the first tick.
+/// </summary>
+void Replay::rewind()
+{
+	this->playRun_ = 0;
+	this->playTick_ = 0;
+}
+
+/// <summary>
+/// Reads keys of the next tick of the playback.
+/// </summary>
+/// <param name="keys">Pressed keys (no keys after the end of the replay).</param>
+/// <returns>Returns `true` if the tick was recorded, else `false` (end of the replay).</returns>
+bool Replay::readNext(std::uint8_t& keys)
+{
+	if (this->isFinished())
+	{
+		keys = INPUT_NONE;
+		return false;
+	}
+
+	keys = this->runs_[this->playRun_].keys;
+	this->playTick_++;
+	if (this->playTick_ >= this->runs_[this->playRun_].ticks)
+	// End of the run -> next one
+	{
+		this->playRun_++;
+		this->playTick_ = 0;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Checks whether all the recorded ticks were played.
+/// </summary>
+/// <returns>Returns `true` if the playback is at the end, else `false`.</returns>
+bool Replay::isFinished() const
+{
+	return this->playRun_ >= this->runs_.size();
+}
+
+/// <summary>
+/// Stores the replay to the binary file.
+/// </summary>
+/// <param name="filename">Filename of the replay file.</param>
+/// <returns>Returns `true` if the file was written, else `false`.</returns>
+bool Replay::save(const std::string& filename) const
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	ReplayHeader header = {};
+	std::memcpy(header.magic, "PRPL", 4);
+	header.version = replayVersion_;
+	header.seed = this->seed_;
+	header.gameIndex = this->gameIndex_;
+	header.tickRate = this->tickRate_;
+	header.levelNameLength = static_cast<std::uint32_t>(this->levelFile_.size());
+	header.tickCount = this->tickCount_;
+	header.runCount = this->runs_.size();
+	header.streamLevel = this->streamLevel_ ? 1 : 0;
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	file.write(this->levelFile_.data(), this->levelFile_.size());
+	file.write(reinterpret_cast<const char*>(this->runs_.data()), this->runs_.size() * sizeof(InputRun));
+
+	return static_cast<bool>(file.flush());
+}
+
+/// <summary>
+/// Loads the replay from the binary file.
+/// </summary>
+/// <param name="filename">Filename of the replay file.</param>
+/// <returns>Returns `true` if the replay was loaded, else `false` (missing file or bad format).</returns>
+bool Replay::load(const std::string& filename)
+{
+	this->clear();
+
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+		return false;
+
+	ReplayHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+	if (std::memcmp(header.magic, "PRPL", 4) != 0 || header.version != replayVersion_)
+		return false;
+	if (!(header.tickRate > 0.0f) || header.runCount > header.tickCount || header.streamLevel > 1)
+		return false;
+
+	// Size check (all the sections must be present).
+	file.seekg(0, std::ios::end);
+	const std::uint64_t expectedSize = sizeof(ReplayHeader) + header.levelNameLength +
+										header.runCount * sizeof(InputRun);
+	if (static_cast<std::uint64_t>(file.tellg()) != expectedSize)
+		return false;
+	file.seekg(sizeof(ReplayHeader), std::ios::beg);
+
+	this->levelFile_.resize(header.levelNameLength);
+	this->runs_.resize(static_cast<std::size_t>(header.runCount));
+	file.read(&this->levelFile_[0], header.levelNameLength);
+	file.read(reinterpret_cast<char*>(this->runs_.data()), this->runs_.size() * sizeof(InputRun));
+	if (!file)
+	{
+		this->clear();
+		return false;
+	}
+
+	// Tick count must match the runs.
+	std::uint64_t tickCount = 0;
+	for (auto&& run : this->runs_)
+	{
+		if (run.ticks == 0)
+		{
+			this->clear();
+			return false;
+		}
+		tickCount += run.ticks;
+	}
+	if (tickCount != header.tickCount)
+	{
+		this->clear();
+		return false;
+	}
+
+	this->seed_ = header.seed;
+	this->gameIndex_ = header.gameIndex;
+	this->tickRate_ = header.tickRate;
+	this->streamLevel_ = header.streamLevel != 0;
+	this->tickCount_ = tickCount;
+	return true;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the recorded ticks.</returns>
+std::uint64_t Replay::getTickCount() const
+{
+	return this->tickCount_;
+}
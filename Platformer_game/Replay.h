@@ -0,0 +1,77 @@
+#ifndef REPLAY_H_
+#define REPLAY_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "PlayerInput.h"
+
+// Header of the replay file.
+// Followed by:	level filename (`levelNameLength` bytes),
+//				input runs (`runCount` x { uint32 ticks, uint8 keys, 3 padding bytes }).
+struct ReplayHeader
+{
+	char magic[4];
+	std::uint32_t version;
+	std::uint64_t seed;
+	std::uint64_t gameIndex;
+	float tickRate;
+	std::uint32_t levelNameLength;
+	std::uint64_t tickCount;
+	std::uint64_t runCount;
+	std::uint8_t streamLevel;
+	std::uint8_t padding[7];
+};
+
+// Recorded input of one game (pressed keys of each tick) and the setup needed
+// to simulate the game again (level, random seed, tick rate and streaming).
+// Same keys held for many ticks are stored as one run (compact files).
+class Replay
+{
+public:
+	// Version of the replay file (files of other versions are not loaded).
+	static const std::uint32_t replayVersion_ = 2;
+
+	// Setup of the recorded game:
+	std::string levelFile_;
+	std::uint64_t seed_ = 0;
+	// Index of the game in the session (random streams of the game depend on it).
+	std::uint64_t gameIndex_ = 0;
+	float tickRate_ = 120.0f;
+	// Was the level streamed (objects far from the player are frozen -> needed for the same result).
+	bool streamLevel_ = false;
+
+	// Recording functions:
+	void clear();
+	void record(std::uint8_t keys);
+
+	// Playback functions:
+	void rewind();
+	bool readNext(std::uint8_t& keys);
+	bool isFinished() const;
+
+	// File functions:
+	bool save(const std::string& filename) const;
+	bool load(const std::string& filename);
+
+	std::uint64_t getTickCount() const;
+
+private:
+	// Keys held for the number of ticks.
+	struct InputRun
+	{
+		std::uint32_t ticks;
+		std::uint8_t keys;
+		std::uint8_t padding[3];
+	};
+
+	std::vector<InputRun> runs_;
+	std::uint64_t tickCount_ = 0;
+
+	// Playback position.
+	std::size_t playRun_ = 0;
+	std::uint32_t playTick_ = 0;
+};
+
+#endif
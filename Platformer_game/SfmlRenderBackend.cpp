@@ -0,0 +1,128 @@
+#include "SfmlRenderBackend.h"
+
+// Public functions:
+
+/// <summary>
+/// Stops the render thread before the window is destroyed.
+/// </summary>
+SfmlRenderBackend::~SfmlRenderBackend()
+{
+	this->renderer_.stop();
+}
+
+/// <summary>
+/// Creates the window in the center of the screen and starts the render thread
+/// (from now on the window is drawn only by the render thread).
+/// </summary>
+/// <param name="videoMode">Size of the window.</param>
+/// <param name="title">Title of the window.</param>
+/// <param name="fontFilename">Filename of the font used by the render thread.</param>
+void SfmlRenderBackend::open(const sf::VideoMode& videoMode, const std::string& title,
+	const std::string& fontFilename)
+{
+	// Set position to the center of the screen.
+	sf::Vector2i centerWindow = sf::Vector2i(
+		(sf::VideoMode::getDesktopMode().width / 2) - videoMode.width / 2,
+		(sf::VideoMode::getDesktopMode().height / 2) - videoMode.height / 2 - 80);
+
+	// Window setup:
+	this->window_.create(videoMode, title, sf::Style::Titlebar | sf::Style::Close);
+	this->window_.setPosition(centerWindow);
+
+	this->renderer_.start(this->window_, fontFilename);
+}
+
+/// <summary>
+/// Stops the render thread and closes the window.
+/// </summary>
+void SfmlRenderBackend::close()
+{
+	this->renderer_.stop();
+	this->window_.close();
+}
+
+/// <summary>
+/// Checks whether the window is still open.
+/// </summary>
+/// <returns>Returns `true` if the window is open, else `false`.</returns>
+bool SfmlRenderBackend::isOpen() const
+{
+	return this->window_.isOpen();
+}
+
+/// <summary>
+/// Gets size of the window.
+/// </summary>
+/// <returns>Returns size of the window (in pixels).</returns>
+sf::Vector2u SfmlRenderBackend::getSize() const
+{
+	return this->window_.getSize();
+}
+
+/// <summary>
+/// Loads the font from the file.
+/// </summary>
+/// <param name="font">Font to be loaded.</param>
+/// <param name="fontFilename">Filename of the font.</param>
+/// <returns>Returns `true` if the font was loaded, else `false`.</returns>
+bool SfmlRenderBackend::loadFont(sf::Font& font, const std::string& fontFilename)
+{
+	return font.loadFromFile(fontFilename);
+}
+
+/// <summary>
+/// Pops the next window event.
+/// </summary>
+/// <param name="event">Event to be filled.</param>
+/// <returns>Returns `true` if some event was pending, else `false`.</returns>
+bool SfmlRenderBackend::pollEvent(sf::Event& event)
+{
+	return this->window_.pollEvent(event);
+}
+
+/// <summary>
+/// Checks whether the key is pressed.
+/// </summary>
+/// <param name="key">Key to be checked.</param>
+/// <returns>Returns `true` if the key is pressed, else `false`.</returns>
+bool SfmlRenderBackend::isKeyPressed(sf::Keyboard::Key key)
+{
+	return sf::Keyboard::isKeyPressed(key);
+}
+
+/// <summary>
+/// Gets position of the mouse in the coordinates of the view.
+/// The view of the window is set by the render thread -> use the given view.
+/// </summary>
+/// <param name="view">View used for the coordinates conversion.</param>
+/// <returns>Returns position of the mouse in the view coordinates.</returns>
+sf::Vector2f SfmlRenderBackend::getMousePosition(const sf::View& view)
+{
+	return this->window_.mapPixelToCoords(sf::Mouse::getPosition(this->window_), view);
+}
+
+/// <summary>
+/// Frames are drawn on the window.
+/// </summary>
+/// <returns>Returns always `true`.</returns>
+bool SfmlRenderBackend::isDrawing() const
+{
+	return true;
+}
+
+/// <summary>
+/// Gets the snapshot of the next frame.
+/// </summary>
+/// <returns>Returns empty snapshot to be filled by the game.</returns>
+RenderSnapshot& SfmlRenderBackend::beginFrame()
+{
+	return this->renderer_.beginFrame();
+}
+
+/// <summary>
+/// Passes the filled snapshot to the render thread.
+/// </summary>
+void SfmlRenderBackend::publishFrame()
+{
+	this->renderer_.publishFrame();
+}
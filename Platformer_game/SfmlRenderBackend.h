@@ -0,0 +1,46 @@
+#ifndef SFMLRENDERBACKEND_H_
+#define SFMLRENDERBACKEND_H_
+
+#include <string>
+
+#include "SFML_includes.h"
+#include "RenderBackend.h"
+#include "Renderer.h"
+
+// Render backend with the real SFML window (frames are drawn by the render thread).
+class SfmlRenderBackend : public RenderBackend
+{
+public:
+	SfmlRenderBackend() = default;
+	~SfmlRenderBackend() override;
+
+	SfmlRenderBackend(const SfmlRenderBackend&) = delete;
+	SfmlRenderBackend& operator=(const SfmlRenderBackend&) = delete;
+
+	// Window functions:
+	void open(const sf::VideoMode& videoMode, const std::string& title,
+		const std::string& fontFilename) override;
+	void close() override;
+	bool isOpen() const override;
+	sf::Vector2u getSize() const override;
+
+	bool loadFont(sf::Font& font, const std::string& fontFilename) override;
+
+	// Input functions:
+	bool pollEvent(sf::Event& event) override;
+	bool isKeyPressed(sf::Keyboard::Key key) override;
+	sf::Vector2f getMousePosition(const sf::View& view) override;
+
+	// Frame functions:
+	bool isDrawing() const override;
+	RenderSnapshot& beginFrame() override;
+	void publishFrame() override;
+
+private:
+	sf::RenderWindow window_;
+
+	// Draws published frames on its own thread (stopped before the window is destroyed).
+	Renderer renderer_;
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "ScriptedBackend.h"
+
+#include <fstream>
+#include <sstream>
+
+/// <summary>
+/// Creates backend without any input.
+/// </summary>
+/// <param name="seed">Seed of the random input.</param>
+ScriptedBackend::ScriptedBackend(std::uint64_t seed)
+	: random_(seed, RANDOM_INPUT)
+{
+}
+
+/// <summary>
+/// Loads the input script.
+/// </summary>
+/// <param name="filename">Filename of the script.</param>
+/// <returns>Returns `true` if the script was loaded, else `false` (bad format or missing file).</returns>
+bool ScriptedBackend::loadScript(const std::string& filename)
+{
+	std::ifstream file(filename);
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream lineStream(line);
+		InputStep step;
+		std::string keys;
+		if (!(lineStream >> step.ticks))
+		// Empty line
+			continue;
+
+		if (!(lineStream >> keys) || step.ticks < 0)
+			return false;
+
+		step.keys = 0;
+		for (char key : keys)
+		{
+			switch (key)
+			{
+				case 'L': step.keys |= INPUT_LEFT; break;
+				case 'R': step.keys |= INPUT_RIGHT; break;
+				case 'U': step.keys |= INPUT_UP; break;
+				case '-': break;
+				default: return false;
+			}
+		}
+		this->script_.push_back(step);
+	}
+
+	this->randomInput_ = false;
+	return true;
+}
+
+/// <summary>
+/// Switches to the random input (random keys held for random number of ticks).
+/// </summary>
+void ScriptedBackend::useRandomInput()
+{
+	this->randomInput_ = true;
+}
+
+/// <summary>
+/// Chooses pressed keys for the next simulation tick 
+/// (no keys are pressed after the end of the script).
+/// </summary>
+void ScriptedBackend::nextTick()
+{
+	if (this->remainingTicks_ > 0)
+	{
+		this->remainingTicks_--;
+		return;
+	}
+
+	if (this->randomInput_)
+	{
+		this->keys_ = static_cast<std::uint8_t>(this->random_.nextBelow((INPUT_LEFT | INPUT_RIGHT | INPUT_UP) + 1));
+		this->remainingTicks_ = 15 + static_cast<int>(this->random_.nextBelow(46)) - 1;
+		return;
+	}
+
+	// Skip empty script steps.
+	while (this->scriptPosition_ < this->script_.size() && this->script_[this->scriptPosition_].ticks == 0)
+		this->scriptPosition_++;
+
+	if (this->scriptPosition_ < this->script_.size())
+	{
+		this->keys_ = this->script_[this->scriptPosition_].keys;
+		this->remainingTicks_ = this->script_[this->scriptPosition_].ticks - 1;
+		this->scriptPosition_++;
+	}
+	else
+		this->keys_ = 0;
+}
+
+/// <summary>
+/// Checks whether the key is pressed in the actual tick.
+/// </summary>
+/// <param name="key">Key to check.</param>
+/// <returns>Returns `true` if the key is pressed, else `false`.</returns>
+bool ScriptedBackend::isKeyPressed(sf::Keyboard::Key key)
+{
+	switch (key)
+	{
+		case sf::Keyboard::Left: return (this->keys_ & INPUT_LEFT) != 0;
+		case sf::Keyboard::Right: return (this->keys_ & INPUT_RIGHT) != 0;
+		case sf::Keyboard::Up: return (this->keys_ & INPUT_UP) != 0;
+		default: return false;
+	}
+}
@@ -0,0 +1,46 @@
+#ifndef SCRIPTEDBACKEND_H_
+#define SCRIPTEDBACKEND_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "../NullRenderBackend.h"
+#include "../RandomStream.h"
+#include "../PlayerInput.h"
+
+// Headless backend with the player input read from the script or generated randomly.
+// Script line:   <ticks> <keys>     (keys `L`, `R`, `U` in any combination or `-` for none)
+class ScriptedBackend : public NullRenderBackend
+{
+public:
+	ScriptedBackend(std::uint64_t seed);
+
+	bool loadScript(const std::string& filename);
+	void useRandomInput();
+
+	// Chooses pressed keys for the next simulation tick.
+	void nextTick();
+
+	bool isKeyPressed(sf::Keyboard::Key key) override;
+
+private:
+	// One part of the script (keys pressed for the number of ticks).
+	struct InputStep
+	{
+		int ticks;
+		std::uint8_t keys;
+	};
+
+	std::vector<InputStep> script_;
+	std::size_t scriptPosition_ = 0;
+
+	bool randomInput_ = false;
+	RandomStream random_;
+
+	// Keys of the actual tick and number of ticks they stay pressed.
+	std::uint8_t keys_ = 0;
+	int remainingTicks_ = 0;
+};
+
+#endif
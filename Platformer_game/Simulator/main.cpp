@@ -0,0 +1,344 @@
+#include <iostream>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "../Game.h"
+#include "../VectorEnvironment.h"
+#include "../RandomStream.h"
+#include "../AabbBatch.h"
+#include "ScriptedBackend.h"
+
+/// <summary>
+/// Steps the batch of games with random actions and prints the throughput.
+/// </summary>
+/// <param name="levelFile">Filename of the level.</param>
+/// <param name="count">Number of the games.</param>
+/// <param name="steps">Number of the steps.</param>
+/// <param name="seed">Seed of the games and of the actions.</param>
+/// <param name="tickRate">Number of simulation ticks per second.</param>
+/// <param name="threadCount">Number of the threads (`0` -> number of hardware threads).</param>
+/// <returns>Returns exit code of the program.</returns>
+static int runEnvironments(const std::string& levelFile, std::size_t count, long long steps,
+                           std::uint64_t seed, float tickRate, std::size_t threadCount)
+{
+    VectorEnvironment environment(levelFile, count, seed, 1, tickRate, threadCount);
+    if (!environment.isLoaded())
+    {
+        std::cout.clear();
+        std::cout << "Level file loading error: " << levelFile << std::endl;
+        return 1;
+    }
+
+    RandomStream random(seed, RANDOM_INPUT);
+    std::vector<std::uint8_t> actions(count);
+    double totalReward = 0.0;
+    long long episodes = 0;
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (long long step = 0; step < steps; step++)
+    {
+        for (auto&& action : actions)
+            action = static_cast<std::uint8_t>(random.nextBelow((INPUT_LEFT | INPUT_RIGHT | INPUT_UP) + 1));
+
+        environment.step(actions.data());
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            totalReward += environment.getRewards()[i];
+            episodes += environment.getDones()[i];
+        }
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+    std::cout.clear();
+    double seconds = duration.count();
+    std::cout << "Games: " << count << ", steps: " << steps << std::endl;
+    std::cout << "Game steps per second: " << (seconds > 0.0 ? count * steps / seconds : 0.0) << std::endl;
+    std::cout << "Finished games: " << episodes << std::endl;
+    std::cout << "Total reward: " << totalReward << std::endl;
+    return 0;
+}
+
+/// <summary>
+/// Tests random boxes against the batch of random boxes by all the supported kernels
+/// (and pair by pair by `sf::FloatRect::intersects`) and prints time per tested pair.
+/// </summary>
+/// <param name="count">Number of the boxes in the batch.</param>
+/// <param name="seed">Seed of the boxes.</param>
+/// <returns>Returns exit code of the program (`1` if the kernels differ).</returns>
+static int benchmarkAabbBatch(std::size_t count, std::uint64_t seed)
+{
+    // Boxes of the enemy size, area is chosen so that each box overlaps few others.
+    RandomStream random(seed, RANDOM_INPUT);
+    const float areaSize = 40.0f * std::sqrt((float)count);
+    std::vector<sf::FloatRect> rects(count);
+    AabbBatch batch;
+    batch.reserve(count);
+    for (auto&& rect : rects)
+    {
+        rect = sf::FloatRect(random.nextFloat(0.0f, areaSize), random.nextFloat(0.0f, areaSize), 40.0f, 40.0f);
+        batch.add(rect);
+    }
+    std::vector<sf::FloatRect> queries(256);
+    for (auto&& query : queries)
+        query = sf::FloatRect(random.nextFloat(0.0f, areaSize), random.nextFloat(0.0f, areaSize), 40.0f, 10.0f);
+
+    // Each variant tests all the queries `repeats` times.
+    const std::size_t repeats = std::max<std::size_t>(1, 20000000 / (count * queries.size()));
+    const double pairs = (double)repeats * queries.size() * count;
+    std::cout.clear();
+    std::cout << "Boxes: " << count << ", tested pairs: " << pairs << std::endl;
+
+    // Pair by pair (previous narrow phase).
+    std::size_t referenceHits = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (std::size_t repeat = 0; repeat < repeats; repeat++)
+    {
+        for (auto&& query : queries)
+        {
+            for (auto&& rect : rects)
+                referenceHits += rect.intersects(query);
+        }
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+    const double pairSeconds = duration.count();
+    std::cout << "FloatRect::intersects: " << pairSeconds * 1e9 / pairs << " ns per pair" << std::endl;
+
+    // Batch kernels (masks are compared with the scalar one).
+    const char* names[] = { "scalar", "SSE", "AVX2" };
+    const SimdLevel supportedLevel = AabbBatch::getSupportedSimdLevel();
+    std::vector<std::vector<std::uint64_t>> scalarMasks(queries.size());
+    std::vector<std::uint64_t> mask;
+    for (int level = SIMD_SCALAR; level <= supportedLevel; level++)
+    {
+        std::size_t hits = 0;
+        startTime = std::chrono::steady_clock::now();
+        for (std::size_t repeat = 0; repeat < repeats; repeat++)
+        {
+            for (std::size_t i = 0; i < queries.size(); i++)
+            {
+                hits += batch.findOverlaps(queries[i], 0, count, mask, (SimdLevel)level);
+                if (repeat > 0)
+                    continue;
+
+                if (level == SIMD_SCALAR)
+                    scalarMasks[i] = mask;
+                else if (mask != scalarMasks[i])
+                {
+                    std::cout << "Kernel " << names[level] << " differs from the scalar one." << std::endl;
+                    return 1;
+                }
+            }
+        }
+        duration = std::chrono::steady_clock::now() - startTime;
+
+        if (hits != referenceHits)
+        {
+            std::cout << "Kernel " << names[level] << " differs from FloatRect::intersects." << std::endl;
+            return 1;
+        }
+        std::cout << "Batch " << names[level] << ": " << duration.count() * 1e9 / pairs << " ns per pair ("
+            << (duration.count() > 0.0 ? pairSeconds / duration.count() : 0.0) << "x)" << std::endl;
+    }
+    std::cout << "Hits: " << referenceHits << std::endl;
+    return 0;
+}
+
+/// <summary>
+/// Measures the collision kernels for `count` to `count + 7` boxes
+/// (each size not divisible by the vector width, kernels also test the remaining boxes).
+/// </summary>
+/// <param name="count">Smallest number of the boxes in the batch.</param>
+/// <param name="seed">Seed of the boxes.</param>
+/// <returns>Returns exit code of the program (`1` if the kernels differ).</returns>
+static int runAabbBenchmark(std::size_t count, std::uint64_t seed)
+{
+    for (std::size_t size = count; size < count + 8; size++)
+    {
+        if (benchmarkAabbBatch(size, seed) != 0)
+            return 1;
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+// Runs the game simulation without any window as fast as possible.
+// Usage:   Simulator <level.txt> [--ticks <n>] [--script <file> | --random] [--seed <n>]
+//                    [--tick-rate <n>] [--stream] [--verbose] [--record <file>] [--threads <n>]
+//          Simulator --replay <file> [--verbose]
+//          Simulator <level.txt> --envs <n> [--threads <n>] [--ticks <n>] [--seed <n>] [--tick-rate <n>]
+//          Simulator --bench-aabb <n> [--seed <n>]
+// Without `--ticks` the simulation runs until the player wins or dies (or the replay ends).
+// The replay uses its own level, seed, tick rate, streaming and input.
+// Prints number of simulated ticks per second, outcome, score and remaining lifes.
+// With `--threads` the entities of the single game are updated in parallel (same result for any number).
+// With `--stream` the level is simulated as streamed (objects far from the player are frozen, no chunks are built).
+// With `--envs` the batch of games is stepped with random actions (`--ticks` steps, 1000 by default).
+// With `--bench-aabb` the collision kernels are measured on `n` to `n + 7` random boxes.
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " <level.txt> [--ticks <n>] [--script <file> | --random]"
+            << " [--seed <n>] [--tick-rate <n>] [--stream] [--verbose] [--record <file>] [--threads <n>]" << std::endl;
+        std::cout << "       " << argv[0] << " --replay <file> [--verbose]" << std::endl;
+        std::cout << "       " << argv[0] << " <level.txt> --envs <n> [--threads <n>] [--ticks <n>]"
+            << " [--seed <n>] [--tick-rate <n>]" << std::endl;
+        std::cout << "       " << argv[0] << " --bench-aabb <n> [--seed <n>]" << std::endl;
+        return 1;
+    }
+
+    std::string levelFile;
+    std::string scriptFile;
+    std::string recordFile;
+    std::string replayFile;
+    long long maxTicks = 0;
+    bool randomInput = false;
+    unsigned long long seed = 0;
+    float tickRate = 120.0f;
+    bool streamLevel = false;
+    bool verbose = false;
+    std::size_t environments = 0;
+    std::size_t threadCount = 0;
+    bool threadsSet = false;
+    std::size_t benchmarkBoxes = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--ticks" && hasValue)
+            maxTicks = std::atoll(argv[++i]);
+        else if (argument == "--script" && hasValue)
+            scriptFile = argv[++i];
+        else if (argument == "--random")
+            randomInput = true;
+        else if (argument == "--seed" && hasValue)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (argument == "--tick-rate" && hasValue)
+            tickRate = (float)std::atof(argv[++i]);
+        else if (argument == "--stream")
+            streamLevel = true;
+        else if (argument == "--verbose")
+            verbose = true;
+        else if (argument == "--record" && hasValue)
+            recordFile = argv[++i];
+        else if (argument == "--replay" && hasValue)
+            replayFile = argv[++i];
+        else if (argument == "--envs" && hasValue)
+            environments = std::strtoul(argv[++i], nullptr, 10);
+        else if (argument == "--threads" && hasValue)
+        {
+            threadCount = std::strtoul(argv[++i], nullptr, 10);
+            threadsSet = true;
+        }
+        else if (argument == "--bench-aabb" && hasValue)
+            benchmarkBoxes = std::strtoul(argv[++i], nullptr, 10);
+        else
+            levelFile = argument;
+    }
+
+    if (benchmarkBoxes > 0)
+        return runAabbBenchmark(benchmarkBoxes, seed);
+
+    // Replayed game -> same setup as the recorded one.
+    Replay replay;
+    if (!replayFile.empty())
+    {
+        if (!replay.load(replayFile))
+        {
+            std::cout << "Cann't read the replay file: " << replayFile << std::endl;
+            return 1;
+        }
+        levelFile = replay.levelFile_;
+        tickRate = replay.tickRate_;
+        streamLevel = replay.streamLevel_;
+    }
+
+    if (levelFile.empty() || tickRate <= 0.0f)
+    {
+        std::cout << "Bad arguments." << std::endl;
+        return 1;
+    }
+
+    // Player input.
+    std::unique_ptr<ScriptedBackend> backend(new ScriptedBackend(seed));
+    if (!scriptFile.empty() && !backend->loadScript(scriptFile))
+    {
+        std::cout << "Cann't read the input script: " << scriptFile << std::endl;
+        return 1;
+    }
+    if (randomInput)
+        backend->useRandomInput();
+    ScriptedBackend& input = *backend;
+
+    // Game logs are printed only in the verbose mode (they would slow the simulation down).
+    if (!verbose)
+        std::cout.setstate(std::ios::failbit);
+
+    if (environments > 0)
+        return runEnvironments(levelFile, environments, maxTicks > 0 ? maxTicks : 1000, seed, tickRate, threadCount);
+
+    std::string fontFile = "Fonts/arial.ttf";
+    Game game(levelFile, fontFile, 5, streamLevel, std::move(backend), tickRate);
+    game.setSeed(seed);
+    if (threadsSet)
+        game.setThreadCount(threadCount);
+    if (!game.running())
+    {
+        std::cout.clear();
+        std::cout << "Level file loading error: " << levelFile << std::endl;
+        return 1;
+    }
+
+    sf::Clock updateClock;
+    if (!replayFile.empty())
+        game.startReplay(replay, updateClock);
+    else
+        game.startGame(updateClock);
+
+    // Simulation loop.
+    auto startTime = std::chrono::steady_clock::now();
+    long long ticks = 0;
+    while (game.playing() && (maxTicks <= 0 || ticks < maxTicks) &&
+           (replayFile.empty() || !game.isReplayFinished()))
+    {
+        input.nextTick();
+        game.simulateTick();
+        ticks++;
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+    std::cout.clear();
+
+    // Results.
+    std::string outcome = "running (tick limit)";
+    int points = game.getPoints();
+    int lifes = game.getLifes();
+    if (!game.playing())
+    {
+        const GameResult& result = game.getLastResult();
+        outcome = result.won ? "won" : "died";
+        points = result.points;
+        lifes = result.lifes;
+    }
+
+    double seconds = duration.count();
+    std::cout << "Ticks: " << ticks << " (" << ticks / tickRate << " s of the game)" << std::endl;
+    std::cout << "Ticks per second: " << (seconds > 0.0 ? ticks / seconds : 0.0) << std::endl;
+    std::cout << "Outcome: " << outcome << std::endl;
+    std::cout << "Score: " << points << std::endl;
+    std::cout << "Lifes: " << lifes << std::endl;
+
+    if (!recordFile.empty() && !game.getRecording().save(recordFile))
+    {
+        std::cout << "Cann't write the replay file: " << recordFile << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
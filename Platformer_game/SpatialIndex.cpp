@@ -0,0 +1,124 @@
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+SpatialIndex::SpatialIndex() {}
+
+/// <summary>
+/// Initializes empty index.
+/// </summary>
+/// <param name="cellSize">Size of one cell (in absolute coordinates).</param>
+SpatialIndex::SpatialIndex(float cellSize)
+	: cellSize_(cellSize)
+{
+}
+
+/// <summary>
+/// Removes all the objects (memory of the cells is kept for the next use).
+/// </summary>
+void SpatialIndex::clear()
+{
+	for (auto key : this->usedCells_)
+	{
+		this->cells_[key].clear();
+	}
+	this->usedCells_.clear();
+}
+
+/// <summary>
+/// Adds the object to all the cells its bounds overlap.
+/// </summary>
+/// <param name="id">Identifier of the object (e.g. index in its container).</param>
+/// <param name="bounds">Absolute bounds of the object.</param>
+void SpatialIndex::insert(std::uint32_t id, const sf::FloatRect& bounds)
+{
+	const auto firstRow = this->getCellCoordinate(bounds.top);
+	const auto lastRow = this->getCellCoordinate(bounds.top + bounds.height);
+	const auto firstColumn = this->getCellCoordinate(bounds.left);
+	const auto lastColumn = this->getCellCoordinate(bounds.left + bounds.width);
+
+	for (auto row = firstRow; row <= lastRow; row++)
+	{
+		for (auto column = firstColumn; column <= lastColumn; column++)
+		{
+			auto key = getCellKey(row, column);
+			auto& cell = this->cells_[key];
+			if (cell.empty())
+				this->usedCells_.push_back(key);
+			cell.push_back(id);
+		}
+	}
+}
+
+/// <summary>
+/// Finds all the objects from the cells overlapping the area
+/// (objects near the area border can lie outside of it).
+/// </summary>
+/// <param name="area">Area to search (absolute coordinates).</param>
+/// <param name="result">Found identifiers (sorted, without duplicates).</param>
+void SpatialIndex::query(const sf::FloatRect& area, std::vector<std::uint32_t>& result) const
+{
+	result.clear();
+
+	const auto firstRow = this->getCellCoordinate(area.top);
+	const auto lastRow = this->getCellCoordinate(area.top + area.height);
+	const auto firstColumn = this->getCellCoordinate(area.left);
+	const auto lastColumn = this->getCellCoordinate(area.left + area.width);
+
+	for (auto row = firstRow; row <= lastRow; row++)
+	{
+		for (auto column = firstColumn; column <= lastColumn; column++)
+		{
+			auto cell = this->cells_.find(getCellKey(row, column));
+			if (cell != this->cells_.end())
+				result.insert(result.end(), cell->second.begin(), cell->second.end());
+		}
+	}
+
+	// Objects overlapping more cells are found more times.
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns size of one cell.</returns>
+float SpatialIndex::getCellSize() const
+{
+	return this->cellSize_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the cells containing some object.</returns>
+std::size_t SpatialIndex::getUsedCellCount() const
+{
+	return this->usedCells_.size();
+}
+
+
+// Private functions:
+
+/// <summary>
+/// </summary>
+/// <param name="coordinate">Absolute coordinate.</param>
+/// <returns>Returns coordinate of the cell containing the given coordinate.</returns>
+std::int64_t SpatialIndex::getCellCoordinate(float coordinate) const
+{
+	return static_cast<std::int64_t>(std::floor(coordinate / this->cellSize_));
+}
+
+/// <summary>
+/// Converts 2D cell coordinates to 64-bit key.
+/// Convertion algorithm:		key = (row << 32) | column
+/// </summary>
+/// <param name="row">Row of the cell.</param>
+/// <param name="column">Column of the cell.</param>
+/// <returns>Returns key of the cell.</returns>
+std::uint64_t SpatialIndex::getCellKey(std::int64_t row, std::int64_t column)
+{
+	return (static_cast<std::uint64_t>(row) << 32) |
+			(static_cast<std::uint64_t>(column) & 0xffffffffULL);
+}
@@ -0,0 +1,43 @@
+#ifndef SPATIALINDEX_H_
+#define SPATIALINDEX_H_
+
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include "SFML_includes.h"
+
+// Uniform grid of square cells containing indices of the objects overlapping them
+// (to find objects in the given area without checking all of them).
+class SpatialIndex
+{
+public:
+	// Initial and setup functions:
+	SpatialIndex();
+	explicit SpatialIndex(float cellSize);
+
+	void clear();
+	void insert(std::uint32_t id, const sf::FloatRect& bounds);
+
+	// Query function:
+	void query(const sf::FloatRect& area, std::vector<std::uint32_t>& result) const;
+
+	// Functions to obtain info about the index:
+	float getCellSize() const;
+	std::size_t getUsedCellCount() const;
+
+private:
+	// Size of one cell (in absolute coordinates).
+	float cellSize_ = 1;
+
+	// Indices of objects in each cell (cells are kept allocated after `clear`).
+	std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells_;
+	// Keys of the non-empty cells.
+	std::vector<std::uint64_t> usedCells_;
+
+	// Coordinates conversion:
+	std::int64_t getCellCoordinate(float coordinate) const;
+	static std::uint64_t getCellKey(std::int64_t row, std::int64_t column);
+};
+
+#endif
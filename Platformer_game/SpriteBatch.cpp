@@ -0,0 +1,91 @@
+#include "SpriteBatch.h"
+
+/// <summary>
+/// Initializes empty batch.
+/// </summary>
+SpriteBatch::SpriteBatch()
+	: vertices_(sf::Quads)
+{
+}
+
+/// <summary>
+/// Removes all the quads (before the next frame).
+/// </summary>
+void SpriteBatch::clear()
+{
+	this->vertices_.clear();
+}
+
+/// <summary>
+/// Adds quad of the shape (its transformation, including rotation, is applied to the corners).
+/// </summary>
+/// <param name="shape">Window object to add.</param>
+void SpriteBatch::add(const sf::RectangleShape& shape)
+{
+	this->add(shape, sf::Vector2f(0.0f, 0.0f));
+}
+
+/// <summary>
+/// Adds the shape moved by the offset (the shape itself is not changed).
+/// </summary>
+/// <param name="shape">Shape to add.</param>
+/// <param name="offset">Offset of the drawn shape from its actual position.</param>
+void SpriteBatch::add(const sf::RectangleShape& shape, sf::Vector2f offset)
+{
+	const sf::Transform& transform = shape.getTransform();
+	const sf::Vector2f& size = shape.getSize();
+	const sf::Color& color = shape.getFillColor();
+
+	this->vertices_.append(sf::Vertex(transform.transformPoint(0, 0) + offset, color));
+	this->vertices_.append(sf::Vertex(transform.transformPoint(size.x, 0) + offset, color));
+	this->vertices_.append(sf::Vertex(transform.transformPoint(size.x, size.y) + offset, color));
+	this->vertices_.append(sf::Vertex(transform.transformPoint(0, size.y) + offset, color));
+}
+
+/// <summary>
+/// Adds the rectangle rotated in the given direction (no transformation of a window object is needed).
+/// </summary>
+/// <param name="center">Center of the rectangle.</param>
+/// <param name="size">Size of the rectangle (not rotated).</param>
+/// <param name="direction">Unit vector of the direction of the rectangle width.</param>
+/// <param name="color">Color of the rectangle.</param>
+void SpriteBatch::add(sf::Vector2f center, sf::Vector2f size, sf::Vector2f direction, const sf::Color& color)
+{
+	const sf::Vector2f alongWidth = direction * (size.x / 2);
+	const sf::Vector2f alongHeight = sf::Vector2f(-direction.y, direction.x) * (size.y / 2);
+
+	this->vertices_.append(sf::Vertex(center - alongWidth - alongHeight, color));
+	this->vertices_.append(sf::Vertex(center + alongWidth - alongHeight, color));
+	this->vertices_.append(sf::Vertex(center + alongWidth + alongHeight, color));
+	this->vertices_.append(sf::Vertex(center - alongWidth + alongHeight, color));
+}
+
+/// <summary>
+/// Adds already prepared quads (e.g. batched static objects).
+/// </summary>
+/// <param name="quads">Quads to add (4 vertices per quad).</param>
+void SpriteBatch::add(const sf::VertexArray& quads)
+{
+	for (std::size_t i = 0; i < quads.getVertexCount(); i++)
+	{
+		this->vertices_.append(quads[i]);
+	}
+}
+
+/// <summary>
+/// Draws all the quads on the window (one draw call).
+/// </summary>
+/// <param name="window">Window where to draw the quads.</param>
+void SpriteBatch::drawTo(sf::RenderWindow& window) const
+{
+	if (this->vertices_.getVertexCount() > 0)
+		window.draw(this->vertices_);
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the quads in the batch.</returns>
+std::size_t SpriteBatch::getQuadCount() const
+{
+	return this->vertices_.getVertexCount() / 4;
+}
@@ -0,0 +1,31 @@
+#ifndef SPRITEBATCH_H_
+#define SPRITEBATCH_H_
+
+#include "SFML_includes.h"
+
+// Collects quads of many window objects and draws them by one draw call.
+// The vertices are rebuilt every frame (memory is kept between the frames).
+class SpriteBatch
+{
+public:
+	// Initial and setup functions:
+	SpriteBatch();
+
+	void clear();
+	void add(const sf::RectangleShape& shape);
+	void add(const sf::RectangleShape& shape, sf::Vector2f offset);
+	void add(sf::Vector2f center, sf::Vector2f size, sf::Vector2f direction, const sf::Color& color);
+	void add(const sf::VertexArray& quads);
+
+	// Display function:
+	void drawTo(sf::RenderWindow& window) const;
+
+	// Functions to obtain info about the batch:
+	std::size_t getQuadCount() const;
+
+private:
+	// Transformed corners of all the added shapes (4 vertices per shape).
+	sf::VertexArray vertices_;
+};
+
+#endif
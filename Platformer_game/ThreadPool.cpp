@@ -0,0 +1,206 @@
+#include "ThreadPool.h"
+
+/// <summary>
+/// Starts the worker threads.
+/// </summary>
+/// <param name="threadCount">Number of threads doing the work including the calling thread
+/// (`0` -> number of hardware threads).</param>
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	for (std::size_t i = 0; i < threadCount; i++)
+	{
+		this->queues_.emplace_back(new WorkQueue());
+	}
+
+	for (std::size_t i = 1; i < threadCount; i++)
+	{
+		this->workers_.emplace_back(&ThreadPool::runWorker, this, i);
+	}
+}
+
+/// <summary>
+/// Stops and joins the worker threads.
+/// </summary>
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex_);
+		this->stop_ = true;
+	}
+	this->startCondition_.notify_all();
+
+	for (auto&& worker : this->workers_)
+	{
+		worker.join();
+	}
+}
+
+/// <summary>
+/// Runs the loop body over ranges covering [0, count), each iteration is one chunk.
+/// Returns after all the ranges are done.
+/// </summary>
+/// <param name="count">Number of the loop iterations.</param>
+/// <param name="body">Loop body called with the range [begin, end).</param>
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body)
+{
+	this->parallelFor(count, 1, body);
+}
+
+/// <summary>
+/// Runs the loop body over chunks of `grainSize` iterations covering [0, count).
+/// Loops with one chunk run directly on the calling thread. Returns after all the chunks are done.
+/// </summary>
+/// <param name="count">Number of the loop iterations.</param>
+/// <param name="grainSize">Number of the iterations in one chunk (last chunk can be smaller).</param>
+/// <param name="body">Loop body called with the range [begin, end) of one chunk.</param>
+void ThreadPool::parallelFor(std::size_t count, std::size_t grainSize,
+							const std::function<void(std::size_t, std::size_t)>& body)
+{
+	if (count == 0)
+		return;
+
+	grainSize = std::max<std::size_t>(1, grainSize);
+	const std::size_t chunks = (count + grainSize - 1) / grainSize;
+	// Nothing to split.
+	if (this->workers_.empty() || chunks == 1)
+	{
+		for (std::size_t begin = 0; begin < count; begin += grainSize)
+			body(begin, std::min(count, begin + grainSize));
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex_);
+		this->body_ = &body;
+		this->count_ = count;
+		this->grainSize_ = grainSize;
+
+		// Each thread starts with its own block of the chunks.
+		const std::size_t threads = this->getThreadCount();
+		for (std::size_t i = 0; i < threads; i++)
+		{
+			std::lock_guard<std::mutex> queueLock(this->queues_[i]->mutex);
+			this->queues_[i]->front = chunks * i / threads;
+			this->queues_[i]->back = chunks * (i + 1) / threads;
+		}
+
+		this->runningWorkers_ = this->workers_.size();
+		this->generation_++;
+	}
+	this->startCondition_.notify_all();
+
+	// The calling thread works too.
+	this->runChunks(0, count, grainSize, body);
+
+	std::unique_lock<std::mutex> lock(this->mutex_);
+	this->doneCondition_.wait(lock, [this] { return this->runningWorkers_ == 0; });
+	this->body_ = nullptr;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of threads doing the work (including the calling thread).</returns>
+std::size_t ThreadPool::getThreadCount() const
+{
+	return this->workers_.size() + 1;
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Worker thread loop (waits for the next loop and does the chunks).
+/// </summary>
+/// <param name="worker">Index of the worker (index of its queue).</param>
+void ThreadPool::runWorker(std::size_t worker)
+{
+	std::size_t seenGeneration = 0;
+	while (true)
+	{
+		const std::function<void(std::size_t, std::size_t)>* body;
+		std::size_t count, grainSize;
+		{
+			std::unique_lock<std::mutex> lock(this->mutex_);
+			this->startCondition_.wait(lock, [this, seenGeneration] {
+				return this->stop_ || this->generation_ != seenGeneration; });
+
+			if (this->stop_)
+				return;
+
+			seenGeneration = this->generation_;
+			body = this->body_;
+			count = this->count_;
+			grainSize = this->grainSize_;
+		}
+
+		this->runChunks(worker, count, grainSize, *body);
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex_);
+			this->runningWorkers_--;
+			if (this->runningWorkers_ == 0)
+				this->doneCondition_.notify_one();
+		}
+	}
+}
+
+/// <summary>
+/// Does own chunks of the loop, then steals the chunks of the others until no chunk is left.
+/// </summary>
+/// <param name="worker">Index of the thread.</param>
+/// <param name="count">Number of the loop iterations.</param>
+/// <param name="grainSize">Number of the iterations in one chunk.</param>
+/// <param name="body">Loop body.</param>
+void ThreadPool::runChunks(std::size_t worker, std::size_t count, std::size_t grainSize,
+						const std::function<void(std::size_t, std::size_t)>& body)
+{
+	std::size_t chunk;
+	while (this->takeChunk(worker, chunk) || this->stealChunk(worker, chunk))
+	{
+		const std::size_t begin = chunk * grainSize;
+		body(begin, std::min(count, begin + grainSize));
+	}
+}
+
+/// <summary>
+/// Takes the first chunk of the own queue.
+/// </summary>
+/// <param name="worker">Index of the thread.</param>
+/// <param name="chunk">Index of the taken chunk.</param>
+/// <returns>Returns `true` if some chunk was taken, else `false` (own queue is empty).</returns>
+bool ThreadPool::takeChunk(std::size_t worker, std::size_t& chunk)
+{
+	WorkQueue& queue = *this->queues_[worker];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.front == queue.back)
+		return false;
+
+	chunk = queue.front++;
+	return true;
+}
+
+/// <summary>
+/// Steals the last chunk of the queue of some other thread (queues after the own one are tried first).
+/// </summary>
+/// <param name="worker">Index of the thread.</param>
+/// <param name="chunk">Index of the stolen chunk.</param>
+/// <returns>Returns `true` if some chunk was stolen, else `false` (all the queues are empty).</returns>
+bool ThreadPool::stealChunk(std::size_t worker, std::size_t& chunk)
+{
+	const std::size_t threads = this->queues_.size();
+	for (std::size_t i = 1; i < threads; i++)
+	{
+		WorkQueue& queue = *this->queues_[(worker + i) % threads];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.front == queue.back)
+			continue;
+
+		chunk = --queue.back;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,69 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+
+// Fixed set of worker threads running parallel loops (`parallelFor`).
+// The loop is split into chunks, each thread starts with its own block of the chunks
+// and when it runs out of them it steals chunks of the other threads (work stealing).
+// The calling thread takes part in the work, the call returns when all the work is done.
+class ThreadPool
+{
+public:
+	// Initial and setup functions:
+	explicit ThreadPool(std::size_t threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Runs `body(begin, end)` over ranges covering [0, count) (one iteration per chunk).
+	void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body);
+	// Runs `body(begin, end)` over chunks of `grainSize` iterations covering [0, count)
+	// (chunk boundaries do not depend on the number of the threads).
+	void parallelFor(std::size_t count, std::size_t grainSize,
+					const std::function<void(std::size_t, std::size_t)>& body);
+
+	// Number of threads doing the work (including the calling thread).
+	std::size_t getThreadCount() const;
+
+private:
+	// Chunks of one thread not done yet, [`front`, `back`) (the owner takes the front, thieves take the back).
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::size_t front = 0;
+		std::size_t back = 0;
+	};
+
+	std::vector<std::thread> workers_;
+	// Queue of each thread (index `0` is the calling thread).
+	std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+	// Actual loop (guarded by `mutex_`):
+	std::mutex mutex_;
+	std::condition_variable startCondition_;
+	std::condition_variable doneCondition_;
+	const std::function<void(std::size_t, std::size_t)>* body_ = nullptr;
+	std::size_t count_ = 0;
+	std::size_t grainSize_ = 1;
+	// Incremented by each loop (workers wait for the next one).
+	std::size_t generation_ = 0;
+	std::size_t runningWorkers_ = 0;
+	bool stop_ = false;
+
+	void runWorker(std::size_t worker);
+	void runChunks(std::size_t worker, std::size_t count, std::size_t grainSize,
+				const std::function<void(std::size_t, std::size_t)>& body);
+	bool takeChunk(std::size_t worker, std::size_t& chunk);
+	bool stealChunk(std::size_t worker, std::size_t& chunk);
+};
+
+#endif
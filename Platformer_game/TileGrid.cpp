@@ -0,0 +1,221 @@
+#include "TileGrid.h"
+
+#include <algorithm>
+
+TileGrid::TileGrid() {}
+
+/// <summary>
+/// Initializes empty grid of the given size.
+/// </summary>
+/// <param name="width">Number of columns.</param>
+/// <param name="height">Number of rows.</param>
+TileGrid::TileGrid(int width, int height)
+{
+	this->reset(width, height);
+}
+
+/// <summary>
+/// Resizes the grid and marks all the cells as empty.
+/// </summary>
+/// <param name="width">Number of columns.</param>
+/// <param name="height">Number of rows.</param>
+void TileGrid::reset(int width, int height)
+{
+	this->width_ = width;
+	this->height_ = height;
+	this->tiles_.assign(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), TILE_EMPTY);
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of columns of the grid.</returns>
+int TileGrid::getWidth() const
+{
+	return this->width_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of rows of the grid.</returns>
+int TileGrid::getHeight() const
+{
+	return this->height_;
+}
+
+/// <summary>
+/// Checks whether the relative coordinates lie inside the grid.
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <returns>Returns `true` if the cell is inside the grid, else `false`.</returns>
+bool TileGrid::isInside(int row, int column) const
+{
+	return row >= 0 && row < this->height_ && column >= 0 && column < this->width_;
+}
+
+/// <summary>
+/// Converts 2D coordinates to the index of the cell in the grid storage.
+/// Convertion algorithm:		result = row * width + column;
+/// </summary>
+/// <param name="row">Relative row coordinate (must be inside the grid).</param>
+/// <param name="column">Relative column coordinate (must be inside the grid).</param>
+/// <returns>Returns index of the cell.</returns>
+std::size_t TileGrid::getIndex(int row, int column) const
+{
+	return static_cast<std::size_t>(row) * static_cast<std::size_t>(this->width_) + 
+			static_cast<std::size_t>(column);
+}
+
+/// <summary>
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <returns>Returns flags of the cell (`TILE_EMPTY` for cells outside the grid).</returns>
+std::uint8_t TileGrid::getTile(int row, int column) const
+{
+	if (!this->isInside(row, column))
+		return TILE_EMPTY;
+
+	return this->tiles_[this->getIndex(row, column)];
+}
+
+/// <summary>
+/// Checks whether the cell contains the given content.
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <param name="flag">Content to check (`TileFlag` value).</param>
+/// <returns>Returns `true` if the cell contains given flag, else `false`.</returns>
+bool TileGrid::hasFlag(int row, int column, std::uint8_t flag) const
+{
+	return (this->getTile(row, column) & flag) != 0;
+}
+
+/// <summary>
+/// Adds the content to the cell (cells outside the grid are ignored).
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <param name="flag">Content to add (`TileFlag` value).</param>
+void TileGrid::setFlag(int row, int column, std::uint8_t flag)
+{
+	if (this->isInside(row, column))
+		this->tiles_[this->getIndex(row, column)] |= flag;
+}
+
+/// <summary>
+/// Removes the content from the cell (cells outside the grid are ignored).
+/// </summary>
+/// <param name="row">Relative row coordinate.</param>
+/// <param name="column">Relative column coordinate.</param>
+/// <param name="flag">Content to remove (`TileFlag` value).</param>
+void TileGrid::clearFlag(int row, int column, std::uint8_t flag)
+{
+	if (this->isInside(row, column))
+		this->tiles_[this->getIndex(row, column)] &= static_cast<std::uint8_t>(~flag);
+}
+
+/// <summary>
+/// Greedily merges the cells with the given content into large rectangles
+/// (each cell of the content is covered by exactly one rectangle).
+/// Cells are scanned in row-major order, each not covered cell starts new rectangle
+/// which is extended to the right as far as possible and then down while whole rows match.
+/// </summary>
+/// <param name="flag">Content to merge (`TileFlag` value).</param>
+/// <param name="firstRow">Top row of the area.</param>
+/// <param name="firstColumn">Left column of the area.</param>
+/// <param name="rows">Number of rows of the area.</param>
+/// <param name="columns">Number of columns of the area.</param>
+/// <returns>Returns merged rectangles in row-major order of their top left cells.</returns>
+std::vector<TileRect> TileGrid::mergeRectangles(std::uint8_t flag, int firstRow, int firstColumn,
+												int rows, int columns) const
+{
+	std::vector<TileRect> rectangles;
+
+	// Clip the area to the grid.
+	const int lastRow = std::min(firstRow + rows, this->height_);
+	const int lastColumn = std::min(firstColumn + columns, this->width_);
+	firstRow = std::max(firstRow, 0);
+	firstColumn = std::max(firstColumn, 0);
+	if (firstRow >= lastRow || firstColumn >= lastColumn)
+		return rectangles;
+
+	rows = lastRow - firstRow;
+	columns = lastColumn - firstColumn;
+
+	// Cells already covered by some rectangle.
+	std::vector<bool> covered(static_cast<std::size_t>(rows) * static_cast<std::size_t>(columns), false);
+
+	auto isFree = [&](int i, int j)
+	{
+		return (this->tiles_[this->getIndex(firstRow + i, firstColumn + j)] & flag) != 0 &&
+			!covered[static_cast<std::size_t>(i) * static_cast<std::size_t>(columns) + j];
+	};
+
+	for (int i = 0; i < rows; i++)
+	{
+		for (int j = 0; j < columns; j++)
+		{
+			if (!isFree(i, j))
+				continue;
+
+			// Extend to the right.
+			int width = 1;
+			while (j + width < columns && isFree(i, j + width))
+				width++;
+
+			// Extend down while the whole row is free.
+			int height = 1;
+			for (bool fullRow = true; fullRow && i + height < rows; )
+			{
+				for (int k = 0; k < width && fullRow; k++)
+					fullRow = isFree(i + height, j + k);
+
+				if (fullRow)
+					height++;
+			}
+
+			for (int k = 0; k < height; k++)
+			{
+				const auto rowStart = static_cast<std::size_t>(i + k) * static_cast<std::size_t>(columns) + j;
+				std::fill(covered.begin() + rowStart, covered.begin() + rowStart + width, true);
+			}
+
+			TileRect rectangle;
+			rectangle.row = firstRow + i;
+			rectangle.column = firstColumn + j;
+			rectangle.rows = height;
+			rectangle.columns = width;
+			rectangles.push_back(rectangle);
+
+			// Skip the rest of the rectangle in this row.
+			j += width - 1;
+		}
+	}
+
+	return rectangles;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns pointer to the first cell of the grid (row-major order).</returns>
+std::uint8_t* TileGrid::getData()
+{
+	return this->tiles_.data();
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns pointer to the first cell of the grid (row-major order).</returns>
+const std::uint8_t* TileGrid::getData() const
+{
+	return this->tiles_.data();
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns total number of the cells in the grid.</returns>
+std::size_t TileGrid::getSize() const
+{
+	return this->tiles_.size();
+}
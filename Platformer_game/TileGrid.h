@@ -0,0 +1,64 @@
+#ifndef TILEGRID_H_
+#define TILEGRID_H_
+
+#include <vector>
+#include <cstdint>
+
+// Flags of the static content of one map cell (can be combined).
+enum TileFlag : std::uint8_t
+{
+	TILE_EMPTY = 0,
+	TILE_OBSTACLE = 1 << 0,
+	TILE_COIN = 1 << 1,
+	TILE_FINISH = 1 << 2
+};
+
+// Rectangle of the cells (relative coordinates of the top left cell and size in cells).
+struct TileRect
+{
+	std::int32_t row = 0;
+	std::int32_t column = 0;
+	std::int32_t rows = 0;
+	std::int32_t columns = 0;
+};
+
+class TileGrid
+{
+public:
+	// Initial and setup functions:
+	TileGrid();
+	TileGrid(int width, int height);
+
+	void reset(int width, int height);
+
+	// Functions to obtain info about the grid:
+	int getWidth() const;
+	int getHeight() const;
+	bool isInside(int row, int column) const;
+	std::size_t getIndex(int row, int column) const;
+
+	// Cell access functions:
+	std::uint8_t getTile(int row, int column) const;
+	bool hasFlag(int row, int column, std::uint8_t flag) const;
+	void setFlag(int row, int column, std::uint8_t flag);
+	void clearFlag(int row, int column, std::uint8_t flag);
+
+	// Merges the cells with the given content into rectangles (only cells inside the area).
+	std::vector<TileRect> mergeRectangles(std::uint8_t flag, int firstRow, int firstColumn,
+											int rows, int columns) const;
+
+	// Raw access to all the cells (row-major order, `getWidth() * getHeight()` bytes):
+	std::uint8_t* getData();
+	const std::uint8_t* getData() const;
+	std::size_t getSize() const;
+
+private:
+	// Relative size of the grid (number of cells in each direction):
+	int width_ = 0;
+	int height_ = 0;
+
+	// One byte of `TileFlag` values per cell (row-major order).
+	std::vector<std::uint8_t> tiles_;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef TRIPLEBUFFER_H_
+#define TRIPLEBUFFER_H_
+
+#include <atomic>
+
+// Lock-free exchange of values between one producer and one consumer thread.
+// The producer fills the write buffer and publishes it, the consumer takes
+// the latest published buffer (older unread values are skipped, nobody waits).
+template <class T>
+class TripleBuffer
+{
+public:
+	// Producer functions:
+	T& getWriteBuffer()
+	{
+		return this->buffers_[this->write_];
+	}
+
+	void publish()
+	{
+		this->write_ = this->middle_.exchange(this->write_ | newFlag_, std::memory_order_acq_rel) & indexMask_;
+	}
+
+	// Consumer functions:
+	bool update()
+	{
+		if ((this->middle_.load(std::memory_order_acquire) & newFlag_) == 0)
+		// Nothing new published.
+			return false;
+
+		this->read_ = this->middle_.exchange(this->read_, std::memory_order_acq_rel) & indexMask_;
+		return true;
+	}
+
+	const T& getReadBuffer() const
+	{
+		return this->buffers_[this->read_];
+	}
+
+private:
+	static const unsigned indexMask_ = 3;
+	static const unsigned newFlag_ = 4;
+
+	T buffers_[3];
+
+	// Buffer owned by the producer, by the consumer and the one between them
+	// (with flag whether it was published and not read yet).
+	unsigned write_ = 0;
+	unsigned read_ = 1;
+	std::atomic<unsigned> middle_{ 2 };
+};
+
+#endif
@@ -0,0 +1,294 @@
+#include "VectorEnvironment.h"
+#include "NullRenderBackend.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Public functions:
+
+/// <summary>
+/// Loads the level once and creates the games (headless, no window, no font).
+/// </summary>
+/// <param name="levelFile">Filename of the level (text or compiled).</param>
+/// <param name="count">Number of the games.</param>
+/// <param name="seed">Seed of the first game (game `i` has seed `seed + i`).</param>
+/// <param name="ticksPerStep">Number of simulation ticks of one step (the action is repeated).</param>
+/// <param name="tickRate">Number of simulation ticks per second.</param>
+/// <param name="threadCount">Number of the threads (`0` -> number of hardware threads).</param>
+VectorEnvironment::VectorEnvironment(const std::string& levelFile, std::size_t count, std::uint64_t seed,
+	int ticksPerStep, float tickRate, std::size_t threadCount)
+	: ticksPerStep_(std::max(1, ticksPerStep)), pool_(threadCount)
+{
+	LevelData data;
+	if (!data.load(levelFile))
+		return;
+	this->level_ = std::make_shared<const LevelData>(std::move(data));
+
+	this->games_.resize(count);
+	this->lastPoints_.assign(count, 0);
+	this->pool_.parallelFor(count, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			std::unique_ptr<RenderBackend> backend(new NullRenderBackend());
+			this->games_[i].reset(new Game(this->level_, 5, std::move(backend), tickRate));
+			this->games_[i]->setSeed(seed + i);
+		}
+	});
+
+	this->tiles_.assign(count * tileWindow_ * tileWindow_, 0);
+	this->entities_.assign(count * maxEntities_ * entityFeatures_, 0.0f);
+	this->players_.assign(count * playerFeatures_, 0.0f);
+	this->rewards_.assign(count, 0.0f);
+	this->dones_.assign(count, 0);
+
+	this->reset();
+}
+
+/// <summary>
+/// Checks whether the level was loaded.
+/// </summary>
+/// <returns>Returns `true` if the games are ready, else `false`.</returns>
+bool VectorEnvironment::isLoaded() const
+{
+	return this->level_ != nullptr;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns number of the games.</returns>
+std::size_t VectorEnvironment::getCount() const
+{
+	return this->games_.size();
+}
+
+/// <summary>
+/// Starts new game in all the games and observes their initial state (rewards and dones are cleared).
+/// </summary>
+void VectorEnvironment::reset()
+{
+	if (!this->isLoaded())
+		return;
+
+	this->pool_.parallelFor(this->games_.size(), [this](std::size_t begin, std::size_t end)
+	{
+		std::vector<NearEntity> nearEntities;
+		for (std::size_t i = begin; i < end; i++)
+		{
+			this->games_[i]->resetGame();
+			this->startGame(i);
+			this->rewards_[i] = 0.0f;
+			this->dones_[i] = 0;
+			this->observe(i, nearEntities);
+		}
+	});
+}
+
+/// <summary>
+/// Steps all the games (in parallel) and fills the batched results.
+/// </summary>
+/// <param name="actions">Action of each game (`InputKey` bit mask, `getCount()` values).</param>
+void VectorEnvironment::step(const std::uint8_t* actions)
+{
+	if (!this->isLoaded())
+		return;
+
+	this->pool_.parallelFor(this->games_.size(), [this, actions](std::size_t begin, std::size_t end)
+	{
+		std::vector<NearEntity> nearEntities;
+		for (std::size_t i = begin; i < end; i++)
+		{
+			this->stepGame(i, actions[i]);
+			this->observe(i, nearEntities);
+		}
+	});
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns tiles around the player of each game.</returns>
+const std::vector<std::uint8_t>& VectorEnvironment::getTiles() const
+{
+	return this->tiles_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns nearest entities of each game.</returns>
+const std::vector<float>& VectorEnvironment::getEntities() const
+{
+	return this->entities_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns player state of each game.</returns>
+const std::vector<float>& VectorEnvironment::getPlayers() const
+{
+	return this->players_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns reward of each game in the last step.</returns>
+const std::vector<float>& VectorEnvironment::getRewards() const
+{
+	return this->rewards_;
+}
+
+/// <summary>
+/// </summary>
+/// <returns>Returns end flag of each game in the last step.</returns>
+const std::vector<std::uint8_t>& VectorEnvironment::getDones() const
+{
+	return this->dones_;
+}
+
+
+// Private functions:
+
+/// <summary>
+/// Simulates one step of the game (the game is started again if it ended).
+/// </summary>
+/// <param name="game">Index of the game.</param>
+/// <param name="action">Pressed keys (`InputKey` bit mask).</param>
+void VectorEnvironment::stepGame(std::size_t game, std::uint8_t action)
+{
+	Game& actGame = *this->games_[game];
+	float reward = 0.0f;
+	bool done = false;
+
+	for (int tick = 0; tick < this->ticksPerStep_ && !done; tick++)
+	{
+		actGame.simulateTick(action);
+
+		if (!actGame.playing())
+		// Game ended (the game is already reset) -> use its result.
+		{
+			const GameResult& result = actGame.getLastResult();
+			reward += (result.points - this->lastPoints_[game]) * coinReward_;
+			if (result.won)
+				reward += finishReward_;
+			done = true;
+		}
+	}
+
+	if (done)
+		this->startGame(game);
+	else
+	{
+		reward += (actGame.getPoints() - this->lastPoints_[game]) * coinReward_;
+		this->lastPoints_[game] = actGame.getPoints();
+	}
+
+	this->rewards_[game] = reward;
+	this->dones_[game] = done ? 1 : 0;
+}
+
+/// <summary>
+/// Starts the game (skips the main menu).
+/// </summary>
+/// <param name="game">Index of the game.</param>
+void VectorEnvironment::startGame(std::size_t game)
+{
+	sf::Clock updateClock;
+	this->games_[game]->startGame(updateClock);
+	this->lastPoints_[game] = this->games_[game]->getPoints();
+}
+
+/// <summary>
+/// Fills the observation of the game (tiles, nearest entities and the player state).
+/// </summary>
+/// <param name="game">Index of the game.</param>
+/// <param name="nearEntities">Buffer for the found entities (reused between the games).</param>
+void VectorEnvironment::observe(std::size_t game, std::vector<NearEntity>& nearEntities)
+{
+	Game& actGame = *this->games_[game];
+	Player& player = actGame.getPlayer();
+	Level& level = actGame.getLevel();
+	const sf::Vector2f& cellSize = level.getObstacleSize();
+
+	// Center of the player (in cells).
+	sf::Vector2f center(
+		(player.absObject_.getLeftBorder() + player.absObject_.getRightBorder()) / 2 / cellSize.x,
+		(player.absObject_.getTopBorder() + player.absObject_.getBottomBorder()) / 2 / cellSize.y);
+
+	this->observeTiles(game, static_cast<int>(std::floor(center.y)), static_cast<int>(std::floor(center.x)));
+
+	// Nearest entities.
+	nearEntities.clear();
+	this->collectEntities(level.getAllEnemies(), ENTITY_ENEMY, center, cellSize, nearEntities);
+	this->collectEntities(level.getAllBullets(), ENTITY_WEAK_BULLET, center, cellSize, nearEntities);
+
+	const std::size_t found = std::min(nearEntities.size(), static_cast<std::size_t>(maxEntities_));
+	std::partial_sort(nearEntities.begin(), nearEntities.begin() + found, nearEntities.end(),
+		[](const NearEntity& first, const NearEntity& second) { return first.distance < second.distance; });
+
+	float* entities = &this->entities_[game * maxEntities_ * entityFeatures_];
+	std::fill(entities, entities + maxEntities_ * entityFeatures_, 0.0f);
+	for (std::size_t i = 0; i < found; i++)
+	{
+		entities[i * entityFeatures_ + 0] = nearEntities[i].x;
+		entities[i * entityFeatures_ + 1] = nearEntities[i].y;
+		entities[i * entityFeatures_ + 2] = nearEntities[i].type;
+	}
+
+	// Player state.
+	float* playerState = &this->players_[game * playerFeatures_];
+	playerState[0] = center.x;
+	playerState[1] = center.y;
+	playerState[2] = static_cast<float>(actGame.getLifes());
+	playerState[3] = static_cast<float>(actGame.getPoints());
+}
+
+/// <summary>
+/// Copies tiles of the window around the cell (collected coins are removed).
+/// </summary>
+/// <param name="game">Index of the game.</param>
+/// <param name="row">Relative row of the center cell.</param>
+/// <param name="column">Relative column of the center cell.</param>
+void VectorEnvironment::observeTiles(std::size_t game, int row, int column)
+{
+	Level& level = this->games_[game]->getLevel();
+	const TileGrid& grid = *level.tileGrid_;
+	std::uint8_t* tiles = &this->tiles_[game * tileWindow_ * tileWindow_];
+
+	for (int i = 0; i < tileWindow_; i++)
+	{
+		for (int j = 0; j < tileWindow_; j++)
+		{
+			const int actRow = row - tileRadius_ + i;
+			const int actColumn = column - tileRadius_ + j;
+			std::uint8_t tile = outsideTile_;
+			if (grid.isInside(actRow, actColumn))
+			{
+				tile = grid.getTile(actRow, actColumn);
+				if ((tile & TILE_COIN) && level.isCoinCollected(actRow, actColumn))
+					tile &= ~TILE_COIN;
+			}
+			tiles[i * tileWindow_ + j] = tile;
+		}
+	}
+}
+
+/// <summary>
+/// Appends the entities with their position relative to the center.
+/// </summary>
+/// <param name="entities">Enemies or bullets.</param>
+/// <param name="type">Observed type of the entities (strong bullets are always `ENTITY_STRONG_BULLET`).</param>
+/// <param name="center">Center of the player (in cells).</param>
+/// <param name="cellSize">Size of the cell (absolute coordinates).</param>
+/// <param name="nearEntities">Container where to add the entities.</param>
+void VectorEnvironment::collectEntities(const EntityStore& entities, ObservedEntity type, sf::Vector2f center,
+										sf::Vector2f cellSize, std::vector<NearEntity>& nearEntities)
+{
+	for (std::size_t i = 0; i < entities.size(); i++)
+	{
+		NearEntity entity;
+		entity.type = (entities.flags_[i] & ENTITY_FLAG_STRONG) ? ENTITY_STRONG_BULLET : type;
+		entity.x = (entities.positionX_[i] + entities.halfExtentX_[i]) / cellSize.x - center.x;
+		entity.y = (entities.positionY_[i] + entities.halfExtentY_[i]) / cellSize.y - center.y;
+		entity.distance = entity.x * entity.x + entity.y * entity.y;
+		nearEntities.push_back(entity);
+	}
+}
@@ -0,0 +1,101 @@
+#ifndef VECTORENVIRONMENT_H_
+#define VECTORENVIRONMENT_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Game.h"
+#include "LevelData.h"
+#include "PlayerInput.h"
+#include "ThreadPool.h"
+
+// Types of the observed entities (`0` -> empty slot).
+enum ObservedEntity : std::uint8_t
+{
+	ENTITY_NONE = 0,
+	ENTITY_ENEMY = 1,
+	ENTITY_WEAK_BULLET = 2,
+	ENTITY_STRONG_BULLET = 3
+};
+
+// Batch of independent headless games of one level stepped together (e.g. for training agents).
+// All the games share the parsed level, each one has its own seed. Each step applies one action
+// (`InputKey` bit mask) to each game and fills contiguous arrays (game-major order):
+//		tiles		- `tileWindow_ x tileWindow_` cells around the player (`TileFlag` values,
+//					  collected coins removed, `outsideTile_` outside of the map),
+//		entities	- `maxEntities_` nearest enemies and bullets { x, y, type } relative to the player (in cells),
+//		players		- { x, y, lifes, points } of the player (position in cells),
+//		rewards		- collected coins (`coinReward_` each) and reached finish (`finishReward_`),
+//		dones		- `1` if the game ended in the step (the game is started again automatically).
+// Games are split between the threads of the pool.
+class VectorEnvironment
+{
+public:
+	// Observation setup:
+	static const int tileRadius_ = 5;
+	static const int tileWindow_ = 2 * tileRadius_ + 1;
+	static const std::uint8_t outsideTile_ = 1 << 7;
+	static const int maxEntities_ = 16;
+	static const int entityFeatures_ = 3;
+	static const int playerFeatures_ = 4;
+
+	// Rewards:
+	static constexpr float coinReward_ = 1.0f;
+	static constexpr float finishReward_ = 10.0f;
+
+	// Initial and setup functions:
+	VectorEnvironment(const std::string& levelFile, std::size_t count, std::uint64_t seed,
+		int ticksPerStep = 1, float tickRate = 120.0f, std::size_t threadCount = 0);
+
+	bool isLoaded() const;
+	std::size_t getCount() const;
+
+	// Stepping functions:
+	void reset();
+	void step(const std::uint8_t* actions);
+
+	// Batched results of the last step (or reset):
+	const std::vector<std::uint8_t>& getTiles() const;
+	const std::vector<float>& getEntities() const;
+	const std::vector<float>& getPlayers() const;
+	const std::vector<float>& getRewards() const;
+	const std::vector<std::uint8_t>& getDones() const;
+
+private:
+	std::shared_ptr<const LevelData> level_;
+	std::vector<std::unique_ptr<Game>> games_;
+	// Points of each game after the last step (for the coin rewards).
+	std::vector<int> lastPoints_;
+
+	const int ticksPerStep_;
+	ThreadPool pool_;
+
+	// Batched results:
+	std::vector<std::uint8_t> tiles_;
+	std::vector<float> entities_;
+	std::vector<float> players_;
+	std::vector<float> rewards_;
+	std::vector<std::uint8_t> dones_;
+
+	// Entity found near the player (squared distance, type, relative position).
+	struct NearEntity
+	{
+		float distance;
+		std::uint8_t type;
+		float x;
+		float y;
+	};
+
+	void stepGame(std::size_t game, std::uint8_t action);
+	void startGame(std::size_t game);
+
+	// Observation functions:
+	void observe(std::size_t game, std::vector<NearEntity>& nearEntities);
+	void observeTiles(std::size_t game, int row, int column);
+	void collectEntities(const EntityStore& entities, ObservedEntity type, sf::Vector2f center,
+						sf::Vector2f cellSize, std::vector<NearEntity>& nearEntities);
+};
+
+#endif
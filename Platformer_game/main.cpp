@@ -1,29 +1,95 @@
 #include <iostream>
 #include <memory>
+#include <cstdlib>
+#include <algorithm>
 
 #include "SFML_includes.h"
 #include "Game.h"
+#include "NullRenderBackend.h"
 
 int main(int argc, char** argv)
 {
     //Init Game engine
     std::string levelFile = "Levels/level_1.txt";
+    bool streamLevel = false;
+    bool headless = false;
+    float tickRate = 120.0f;
+    unsigned long long seed = 0;
+    std::string recordFile;
+    std::string replayFile;
+    float replaySpeed = 1.0f;
 
     // Run test or other level than default
-    // (filename of the level file is the first argument).
-    if (argc > 1)
-        levelFile = argv[1];
+    // (filename of the level file is the first argument),
+    // `--stream` switches on streaming of the level around the view,
+    // `--headless` plays one game without any window (ends with the end of the game),
+    // `--tick-rate <n>` sets number of the simulation ticks per second,
+    // `--seed <n>` sets seed of the random behaviour of the enemies (same seed -> same run),
+    // `--record <file>` stores input of the last played game to the replay file,
+    // `--replay <file>` plays the recorded game (its level, seed, tick rate and streaming are used),
+    // `--replay-speed <x>` sets speed of the replay (e.g. `4` -> four times faster).
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--stream")
+            streamLevel = true;
+        else if (argument == "--headless")
+            headless = true;
+        else if (argument == "--tick-rate" && i + 1 < argc)
+            tickRate = std::max(1.0f, (float)std::atof(argv[++i]));
+        else if (argument == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (argument == "--record" && i + 1 < argc)
+            recordFile = argv[++i];
+        else if (argument == "--replay" && i + 1 < argc)
+            replayFile = argv[++i];
+        else if (argument == "--replay-speed" && i + 1 < argc)
+            replaySpeed = std::max(0.01f, (float)std::atof(argv[++i]));
+        else
+            levelFile = argument;
+    }
+
+    // Replayed game -> same setup as the recorded one.
+    Replay replay;
+    if (!replayFile.empty())
+    {
+        if (!replay.load(replayFile))
+        {
+            std::cout << "Cann't read the replay file: " << replayFile << std::endl;
+            return 1;
+        }
+        levelFile = replay.levelFile_;
+        tickRate = replay.tickRate_;
+        streamLevel = replay.streamLevel_;
+    }
 
     std::string fontFile = "Fonts/arial.ttf";
-    Game game(levelFile, fontFile, 5);
+    std::unique_ptr<RenderBackend> backend;
+    if (headless)
+        backend.reset(new NullRenderBackend());
+    Game game(levelFile, fontFile, 5, streamLevel, std::move(backend), tickRate);
+    game.setSeed(seed);
+    // Big levels update the entities on all the cores (small ones stay on the calling thread).
+    game.setThreadCount(0);
 
 
     float sleepIntervalSec = 0.01f;
     sf::Clock updateClock;
     updateClock.restart();
 
-    //Game loop
-    while (game.running())
+    // There is no main menu without the window (or the replay) -> start the game directly.
+    bool replaying = !replayFile.empty();
+    if (replaying)
+    {
+        game.setTimeScale(replaySpeed);
+        game.startReplay(replay, updateClock);
+    }
+    else if (headless)
+        game.startGame(updateClock);
+
+    //Game loop (replay ends with the end of the recorded input)
+    while (game.running() && (!headless || game.playing()) &&
+           (!replaying || (game.playing() && !game.isReplayFinished())))
     {
         //Update
         game.update(updateClock);
@@ -36,6 +102,10 @@ int main(int argc, char** argv)
             sleepIntervalSec - updateClock.getElapsedTime().asSeconds()));
     }
 
+    // Store the last played game.
+    if (!recordFile.empty() && !game.getRecording().save(recordFile))
+        std::cout << "Cann't write the replay file: " << recordFile << std::endl;
+
     //End of application
     return 0;
 }
\ No newline at end of file